@@ -0,0 +1,120 @@
+// Startup cost of adapter probing with mocked adapters
+//
+// Compares the former sequential probing, where every adapter loaded and
+// released the Vulkan loader on its own, with the registry's current path,
+// which loads the loader once and runs the registry's startProbing on
+// mocked adapters. Driver calls are mocked with sleeps, their durations in
+// milliseconds can be passed as arguments: loader extensions properties outputs
+
+#include "../src/sysinfo/nvapi_adapter_probe.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace dxvk;
+
+struct MockCosts {
+    std::chrono::milliseconds loader{20};
+    std::chrono::milliseconds extensions{3};
+    std::chrono::milliseconds properties{5};
+    std::chrono::milliseconds outputs{8};
+};
+
+class MockAdapter {
+
+public:
+    explicit MockAdapter(const MockCosts& costs) : m_costs(costs) {}
+
+    void LoadLoader() const {
+        std::this_thread::sleep_for(m_costs.loader);
+    }
+
+    void EnsureVulkanProperties() const {
+        std::this_thread::sleep_for(m_costs.extensions);
+        std::this_thread::sleep_for(m_costs.properties);
+    }
+
+    void InitializeOutputs(const size_t index, std::vector<size_t>& outputs) const {
+        std::this_thread::sleep_for(m_costs.outputs);
+        outputs.push_back(index);
+    }
+
+private:
+    MockCosts m_costs;
+};
+
+template<typename F>
+static double measure(F f) {
+    constexpr auto runs = 5;
+    auto best = std::chrono::steady_clock::duration::max();
+    for (auto i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::steady_clock::now() - start);
+    }
+
+    return std::chrono::duration<double, std::milli>(best).count();
+}
+
+static std::vector<size_t> probeSequential(std::vector<MockAdapter*>& adapters) {
+    std::vector<size_t> outputs;
+    for (auto i = 0U; i < adapters.size(); i++) {
+        adapters[i]->LoadLoader();
+        adapters[i]->EnsureVulkanProperties();
+        adapters[i]->InitializeOutputs(i, outputs);
+    }
+
+    return outputs;
+}
+
+static std::vector<size_t> probePooled(std::vector<MockAdapter*>& adapters) {
+    adapters.front()->LoadLoader();
+
+    std::vector<std::vector<size_t>> probedOutputs;
+    WorkPool pool;
+    startProbing(pool, adapters, probedOutputs);
+    pool.Join();
+
+    std::vector<size_t> outputs;
+    for (const auto& probed : probedOutputs)
+        outputs.insert(outputs.end(), probed.begin(), probed.end());
+
+    return outputs;
+}
+
+int main(int argc, char** argv) {
+    MockCosts costs;
+    std::chrono::milliseconds* fields[] = {&costs.loader, &costs.extensions, &costs.properties, &costs.outputs};
+    for (auto i = 1; i < argc && i <= 4; i++)
+        *fields[i - 1] = std::chrono::milliseconds(std::atoi(argv[i]));
+
+    std::printf("Mocked costs: loader %lld ms, extensions %lld ms, properties %lld ms, outputs %lld ms\n",
+        static_cast<long long>(costs.loader.count()), static_cast<long long>(costs.extensions.count()),
+        static_cast<long long>(costs.properties.count()), static_cast<long long>(costs.outputs.count()));
+    std::printf("Hardware threads: %u, probing uses up to %u threads regardless\n", std::thread::hardware_concurrency(), maxProbeThreads);
+    std::printf("%-9s %14s %14s %8s\n", "adapters", "sequential ms", "pooled ms", "speedup");
+
+    auto failed = false;
+    for (auto count : {1U, 2U, 4U}) {
+        std::vector<MockAdapter> mockAdapters(count, MockAdapter(costs));
+        std::vector<MockAdapter*> adapters;
+        for (auto& adapter : mockAdapters)
+            adapters.push_back(&adapter);
+
+        // Output order has to stay the adapter order regardless of scheduling
+        if (probeSequential(adapters) != probePooled(adapters)) {
+            std::printf("%-9u output order differs\n", count);
+            failed = true;
+            continue;
+        }
+
+        auto sequential = measure([&] { probeSequential(adapters); });
+        auto pooled = measure([&] { probePooled(adapters); });
+        std::printf("%-9u %14.1f %14.1f %7.2fx\n", count, sequential, pooled, sequential / pooled);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
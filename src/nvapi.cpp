@@ -7,6 +7,8 @@
 #include "util/util_log.h"
 #include "../version.h"
 
+#include <mutex>
+
 #ifdef __GNUC__
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif // __GNUC__
@@ -17,16 +19,17 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_EnumLogicalGPUs(NvLogicalGpuHandle nvGPUHandle[NVAPI_MAX_LOGICAL_GPUS], NvU32 *pGpuCount) {
         constexpr auto n = "NvAPI_EnumLogicalGPUs";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (nvGPUHandle == nullptr || pGpuCount == nullptr)
             return InvalidArgument(n);
 
-        for (auto i = 0U; i < nvapiAdapterRegistry->GetAdapterCount(); i++)
-            nvGPUHandle[i] = reinterpret_cast<NvLogicalGpuHandle>(nvapiAdapterRegistry->GetAdapter(i));
+        for (auto i = 0U; i < nvapiAdapterRegistry->GetLogicalGpuCount(); i++)
+            nvGPUHandle[i] = nvapiAdapterRegistry->GetLogicalGpuHandle(i);
 
-        *pGpuCount = nvapiAdapterRegistry->GetAdapterCount();
+        *pGpuCount = nvapiAdapterRegistry->GetLogicalGpuCount();
 
         return Ok(n);
     }
@@ -34,6 +37,7 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_EnumPhysicalGPUs(NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS], NvU32 *pGpuCount) {
         constexpr auto n = "NvAPI_EnumPhysicalGPUs";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
@@ -41,7 +45,7 @@ extern "C" {
             return InvalidArgument(n);
 
         for (auto i = 0U; i < nvapiAdapterRegistry->GetAdapterCount(); i++)
-            nvGPUHandle[i] = reinterpret_cast<NvPhysicalGpuHandle>(nvapiAdapterRegistry->GetAdapter(i));
+            nvGPUHandle[i] = nvapiAdapterRegistry->GetPhysicalGpuHandle(i);
 
         *pGpuCount = nvapiAdapterRegistry->GetAdapterCount();
 
@@ -51,6 +55,7 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GetDisplayDriverVersion(NvDisplayHandle hNvDisplay, NV_DISPLAY_DRIVER_VERSION *pVersion) {
         constexpr auto n = "NvAPI_GetDisplayDriverVersion";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
@@ -72,36 +77,99 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GetPhysicalGPUsFromDisplay(NvDisplayHandle hNvDisp, NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS], NvU32 *pGpuCount) {
         constexpr auto n = "NvAPI_GetPhysicalGPUsFromDisplay";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (hNvDisp == nullptr || nvGPUHandle == nullptr || pGpuCount == nullptr)
             return InvalidArgument(n);
 
-        auto output = reinterpret_cast<NvapiOutput*>(hNvDisp);
-        if (!nvapiAdapterRegistry->IsOutput(output))
+        auto output = nvapiAdapterRegistry->GetOutput(hNvDisp);
+        if (output == nullptr)
             return ExpectedDisplayHandle(n);
 
-        nvGPUHandle[0] = reinterpret_cast<NvPhysicalGpuHandle>(output->GetParent());
+        nvGPUHandle[0] = nvapiAdapterRegistry->GetPhysicalGpuHandle(output->GetParent());
         *pGpuCount = 1;
 
         return Ok(n);
     }
 
+    NvAPI_Status __cdecl NvAPI_GetLogicalGPUFromDisplay(NvDisplayHandle hNvDisp, NvLogicalGpuHandle *pLogicalGPU) {
+        constexpr auto n = "NvAPI_GetLogicalGPUFromDisplay";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hNvDisp == nullptr || pLogicalGPU == nullptr)
+            return InvalidArgument(n);
+
+        auto output = nvapiAdapterRegistry->GetOutput(hNvDisp);
+        if (output == nullptr)
+            return ExpectedDisplayHandle(n);
+
+        *pLogicalGPU = nvapiAdapterRegistry->GetLogicalGpuHandle(nvapiAdapterRegistry->GetLogicalGpuIndex(output->GetParent()));
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GetLogicalGPUFromPhysicalGPU(NvPhysicalGpuHandle hPhysicalGPU, NvLogicalGpuHandle *pLogicalGPU) {
+        constexpr auto n = "NvAPI_GetLogicalGPUFromPhysicalGPU";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGPU == nullptr || pLogicalGPU == nullptr)
+            return InvalidArgument(n);
+
+        auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGPU);
+        if (index == -1)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pLogicalGPU = nvapiAdapterRegistry->GetLogicalGpuHandle(nvapiAdapterRegistry->GetLogicalGpuIndex(static_cast<u_short>(index)));
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GetPhysicalGPUsFromLogicalGPU(NvLogicalGpuHandle hLogicalGPU, NvPhysicalGpuHandle hPhysicalGPU[NVAPI_MAX_PHYSICAL_GPUS], NvU32 *pGpuCount) {
+        constexpr auto n = "NvAPI_GetPhysicalGPUsFromLogicalGPU";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hLogicalGPU == nullptr || hPhysicalGPU == nullptr || pGpuCount == nullptr)
+            return InvalidArgument(n);
+
+        auto index = nvapiAdapterRegistry->GetLogicalGpuIndex(hLogicalGPU);
+        if (index == -1)
+            return ExpectedLogicalGpuHandle(n);
+
+        const auto& adapters = nvapiAdapterRegistry->GetLogicalGpuAdapters(index);
+        for (auto i = 0U; i < adapters.size(); i++)
+            hPhysicalGPU[i] = nvapiAdapterRegistry->GetPhysicalGpuHandle(adapters[i]);
+
+        *pGpuCount = adapters.size();
+
+        return Ok(n);
+    }
+
     NvAPI_Status __cdecl NvAPI_EnumNvidiaDisplayHandle(NvU32 thisEnum, NvDisplayHandle *pNvDispHandle) {
         constexpr auto n = "NvAPI_EnumNvidiaDisplayHandle";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (pNvDispHandle == nullptr)
             return InvalidArgument(n);
 
-        auto output = nvapiAdapterRegistry->GetOutput(thisEnum);
-        if (output == nullptr)
+        auto handle = nvapiAdapterRegistry->GetDisplayHandle(thisEnum);
+        if (handle == nullptr)
             return EndEnumeration(str::format(n, " ", thisEnum));
 
-        *pNvDispHandle = reinterpret_cast<NvDisplayHandle>(output);
+        *pNvDispHandle = handle;
 
         return Ok(str::format(n, " ", thisEnum));
     }
@@ -134,14 +202,21 @@ extern "C" {
         return Ok(str::format(n, " ", nr, " (", error, ")"));
     }
 
+    // Serializes NvAPI_Initialize and NvAPI_Unload, entry points never wait for it
+    static std::mutex initializationMutex;
+
     NvAPI_Status __cdecl NvAPI_Unload() {
         constexpr auto n = "NvAPI_Unload";
 
+        std::scoped_lock lock(initializationMutex);
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Exchange(nullptr);
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
+        // Wait for calls that still use the unpublished registry
+        rcu::synchronize();
         delete nvapiAdapterRegistry;
-        nvapiAdapterRegistry = nullptr;
 
         return Ok(n);
     }
@@ -149,14 +224,21 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_Initialize() {
         constexpr auto n = "NvAPI_Initialize";
 
-        if (nvapiAdapterRegistry != nullptr)
+        std::scoped_lock lock(initializationMutex);
+
+        if (publishedAdapterRegistry.Acquire() != nullptr)
             return Ok(n);
 
         log::write(str::format("DXVK-NVAPI ", DXVK_NVAPI_VERSION, " (", env::getExecutableName(), ")"));
 
-        nvapiAdapterRegistry = new NvapiAdapterRegistry();
-        if (!nvapiAdapterRegistry->Initialize())
+        auto nvapiAdapterRegistry = new NvapiAdapterRegistry();
+        if (!nvapiAdapterRegistry->Initialize()) {
+            delete nvapiAdapterRegistry;
             return NvidiaDeviceNotFound(n);
+        }
+
+        // Nothing was published before, there is no previous registry to reclaim
+        publishedAdapterRegistry.Exchange(nvapiAdapterRegistry);
 
         return Ok(n);
     }
@@ -1,6 +1,54 @@
 #include "nvapi_private.h"
+#include "nvapi_static.h"
+#include "util/com_pointer.h"
 #include "util/util_statuscode.h"
 
+namespace dxvk {
+    // Adapter the device was created on, -1 if unknown
+    static short getAdapterIndex(const NvapiAdapterRegistry* nvapiAdapterRegistry, IUnknown* pDeviceOrContext) {
+        Com<ID3D11Device> d3d11Device;
+        if (FAILED(pDeviceOrContext->QueryInterface(IID_PPV_ARGS(&d3d11Device)))) {
+            Com<ID3D11DeviceChild> d3d11DeviceChild;
+            if (FAILED(pDeviceOrContext->QueryInterface(IID_PPV_ARGS(&d3d11DeviceChild))))
+                return -1;
+
+            d3d11DeviceChild->GetDevice(&d3d11Device);
+        }
+
+        Com<IDXGIDevice> dxgiDevice;
+        Com<IDXGIAdapter> dxgiAdapter;
+        DXGI_ADAPTER_DESC desc;
+        if (FAILED(d3d11Device->QueryInterface(IID_PPV_ARGS(&dxgiDevice)))
+            || FAILED(dxgiDevice->GetAdapter(&dxgiAdapter))
+            || FAILED(dxgiAdapter->GetDesc(&desc)))
+            return -1;
+
+        for (auto i = 0U; i < nvapiAdapterRegistry->GetAdapterCount(); i++) {
+            const auto& luid = nvapiAdapterRegistry->GetAdapter(i)->GetDxgiLUID();
+            if (luid.LowPart == desc.AdapterLuid.LowPart
+                && luid.HighPart == desc.AdapterLuid.HighPart)
+                return static_cast<short>(i);
+        }
+
+        return -1;
+    }
+
+    // VRR capability is cached per output, any capable output of the device's adapter counts
+    static bool isVrrCapable(const NvapiAdapterRegistry* nvapiAdapterRegistry, IUnknown* pDeviceOrContext) {
+        auto index = getAdapterIndex(nvapiAdapterRegistry, pDeviceOrContext);
+        if (index == -1)
+            return false;
+
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        for (auto i = 0U; i < topology->GetOutputCount(); i++) {
+            if (topology->GetOutputParent(i) == index && topology->GetOutput(i)->IsVrrCapable())
+                return true;
+        }
+
+        return false;
+    }
+}
+
 extern "C" {
     using namespace dxvk;
 
@@ -36,4 +84,37 @@ extern "C" {
 
         return Ok(n);
     }
+
+    NvAPI_Status __cdecl NvAPI_D3D_IsGSyncCapable(IUnknown *pDeviceOrContext, NVDX_ObjectHandle primarySurface, BOOL *pIsGsyncCapable) {
+        constexpr auto n = "NvAPI_D3D_IsGSyncCapable";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pDeviceOrContext == nullptr || pIsGsyncCapable == nullptr)
+            return InvalidArgument(n);
+
+        *pIsGsyncCapable = isVrrCapable(nvapiAdapterRegistry.get(), pDeviceOrContext);
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_D3D_IsGSyncActive(IUnknown *pDeviceOrContext, NVDX_ObjectHandle primarySurface, BOOL *pIsGsyncActive) {
+        constexpr auto n = "NvAPI_D3D_IsGSyncActive";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pDeviceOrContext == nullptr || pIsGsyncActive == nullptr)
+            return InvalidArgument(n);
+
+        // The swapchain is not visible from here, so whether VRR is in use for it is unknown
+        *pIsGsyncActive = FALSE;
+
+        return Ok(n, alreadyLogged);
+    }
 }
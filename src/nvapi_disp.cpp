@@ -3,12 +3,57 @@
 #include "util/util_statuscode.h"
 #include "util/util_string.h"
 
+namespace dxvk {
+    // Paths are prepared with the topology snapshot, index i is the path of output i
+    template<typename PathInfo>
+    static void getDisplayConfig(const NvapiTopology* topology, PathInfo* pathInfo, const NvU32 pathInfoCount) {
+        for (auto i = 0U; i < pathInfoCount; i++) {
+            auto& path = pathInfo[i];
+            path.reserved_sourceId = i;
+
+            if (path.targetInfo != nullptr && path.targetInfoCount != 0) {
+                path.targetInfo[0].displayId = topology->GetOutputId(i);
+                if (path.targetInfo[0].details != nullptr)
+                    std::memcpy(path.targetInfo[0].details, &topology->GetTargetInfo(i), sizeof(NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1));
+            }
+
+            path.targetInfoCount = 1;
+
+            if (path.sourceModeInfo != nullptr)
+                std::memcpy(path.sourceModeInfo, &topology->GetSourceModeInfo(i), sizeof(NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1));
+
+            if constexpr (std::is_same_v<PathInfo, NV_DISPLAYCONFIG_PATH_INFO_V2>)
+                path.IsNonNVIDIAAdapter = false;
+        }
+    }
+
+    // EDID timing closest to the requested refresh rate, within 1 Hz to match e.g. 59.94 Hz for 60 Hz
+    static const NV_TIMING* findTiming(const NvapiEdidInfo& edidInfo, const NvU32 width, const NvU32 height, const NvU32 refreshRate1K) {
+        const NV_TIMING* match = nullptr;
+        auto matchDistance = 1000U;
+        for (const auto& timing : edidInfo.timings) {
+            if (timing.HVisible != width || timing.VVisible != height)
+                continue;
+
+            auto distance = refreshRate1K != 0 ? static_cast<NvU32>(std::abs(static_cast<int64_t>(timing.etc.rrx1k) - refreshRate1K)) : 0;
+            if (distance < matchDistance) {
+                match = &timing;
+                matchDistance = distance;
+            }
+        }
+
+        return match;
+    }
+}
+
 extern "C" {
     using namespace dxvk;
 
     NvAPI_Status __cdecl NvAPI_Disp_GetHdrCapabilities(NvU32 displayId, NV_HDR_CAPABILITIES *pHdrCapabilities) {
         constexpr auto n = "NvAPI_Disp_GetHdrCapabilities";
+        static bool alreadyLogged = false;
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
@@ -18,32 +63,40 @@ extern "C" {
         if (pHdrCapabilities->version != NV_HDR_CAPABILITIES_VER1 && pHdrCapabilities->version != NV_HDR_CAPABILITIES_VER2)
             return IncompatibleStructVersion(n);
 
-        // Report that HDR is not available
-        pHdrCapabilities->isST2084EotfSupported = false;
-        pHdrCapabilities->isTraditionalHdrGammaSupported = false;
-        pHdrCapabilities->isEdrSupported = false;
-        pHdrCapabilities->driverExpandDefaultHdrParameters = false;
-        pHdrCapabilities->isTraditionalSdrGammaSupported = false;
-        // pHdrCapabilities->display_data
+        auto output = nvapiAdapterRegistry->GetOutputById(displayId);
+        if (output == nullptr)
+            return InvalidDisplayId(str::format(n, " ", displayId));
 
-        if (pHdrCapabilities->version == NV_HDR_CAPABILITIES_VER2)
-            pHdrCapabilities->isDolbyVisionSupported = false;
-            // pHdrCapabilities->dv_static_metadata
+        // Built once per output from DXGI and its EDID, titles query this every frame
+        const auto& capabilities = output->GetHdrCapabilities();
+        pHdrCapabilities->isST2084EotfSupported = capabilities.isST2084EotfSupported;
+        pHdrCapabilities->isTraditionalHdrGammaSupported = capabilities.isTraditionalHdrGammaSupported;
+        pHdrCapabilities->isEdrSupported = capabilities.isEdrSupported;
+        pHdrCapabilities->driverExpandDefaultHdrParameters = capabilities.driverExpandDefaultHdrParameters;
+        pHdrCapabilities->isTraditionalSdrGammaSupported = capabilities.isTraditionalSdrGammaSupported;
+        pHdrCapabilities->static_metadata_descriptor_id = capabilities.static_metadata_descriptor_id;
+        std::memcpy(&pHdrCapabilities->display_data, &capabilities.display_data, sizeof(capabilities.display_data));
 
-        return Ok(str::format(n, " ", displayId));
+        if (pHdrCapabilities->version == NV_HDR_CAPABILITIES_VER2) {
+            pHdrCapabilities->isDolbyVisionSupported = capabilities.isDolbyVisionSupported;
+            std::memcpy(&pHdrCapabilities->dv_static_metadata, &capabilities.dv_static_metadata, sizeof(capabilities.dv_static_metadata));
+        }
+
+        return Ok(n, alreadyLogged);
     }
 
     NvAPI_Status __cdecl NvAPI_DISP_GetDisplayIdByDisplayName(const char *displayName, NvU32 *displayId) {
         constexpr auto n = "NvAPI_DISP_GetDisplayIdByDisplayName";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (displayName == nullptr || displayId == nullptr)
             return InvalidArgument(n);
 
-        auto id = nvapiAdapterRegistry->GetOutputId(std::string(displayName));
-        if (id == -1)
+        auto id = nvapiAdapterRegistry->GetOutputId(displayName);
+        if (id == 0)
             return InvalidArgument(str::format(n, " ", displayName));
 
         *displayId = id;
@@ -54,15 +107,179 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_DISP_GetGDIPrimaryDisplayId(NvU32 *displayId) {
         constexpr auto n = "NvAPI_DISP_GetGDIPrimaryDisplayId";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
         if (displayId == nullptr)
             return InvalidArgument(n);
 
         auto id = nvapiAdapterRegistry->GetPrimaryOutputId();
-        if (id == -1)
+        if (id == 0)
             return NvidiaDeviceNotFound(n);
 
         *displayId = id;
 
         return Ok(n);
     }
+
+    NvAPI_Status __cdecl NvAPI_DISP_GetAdaptiveSyncData(NvU32 displayId, NV_GET_ADAPTIVE_SYNC_DATA *pAdaptiveSyncData) {
+        constexpr auto n = "NvAPI_DISP_GetAdaptiveSyncData";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pAdaptiveSyncData == nullptr)
+            return InvalidArgument(n);
+
+        if (pAdaptiveSyncData->version != NV_GET_ADAPTIVE_SYNC_DATA_VER1)
+            return IncompatibleStructVersion(n);
+
+        auto output = nvapiAdapterRegistry->GetOutputById(displayId);
+        if (output == nullptr)
+            return InvalidDisplayId(str::format(n, " ", displayId));
+
+        // Nothing was changed through NvAPI_DISP_SetAdaptiveSyncData, thus the EDID defaults apply
+        *pAdaptiveSyncData = {};
+        pAdaptiveSyncData->version = NV_GET_ADAPTIVE_SYNC_DATA_VER1;
+        pAdaptiveSyncData->maxFrameInterval = 0;
+        pAdaptiveSyncData->bDisableAdaptiveSync = !output->IsVrrCapable();
+        pAdaptiveSyncData->bDisableFrameSplitting = false;
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_DISP_GetDisplayConfig(NvU32 *pathInfoCount, NV_DISPLAYCONFIG_PATH_INFO *pathInfo) {
+        constexpr auto n = "NvAPI_DISP_GetDisplayConfig";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pathInfoCount == nullptr || (*pathInfoCount == 0) != (pathInfo == nullptr))
+            return InvalidArgument(n);
+
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto count = static_cast<NvU32>(topology->GetOutputCount());
+        if (pathInfo == nullptr) {
+            *pathInfoCount = count;
+            return Ok(n, alreadyLogged);
+        }
+
+        // Version 1 paths and targets are smaller, all elements have to agree on the layout
+        auto capacity = *pathInfoCount;
+        auto version = pathInfo[0].version;
+        if (version == NV_DISPLAYCONFIG_PATH_INFO_VER1) {
+            auto pathInfoV1 = reinterpret_cast<NV_DISPLAYCONFIG_PATH_INFO_V1*>(pathInfo);
+            if (std::any_of(pathInfoV1, pathInfoV1 + capacity, [](const auto& path) { return path.version != NV_DISPLAYCONFIG_PATH_INFO_VER1; }))
+                return IncompatibleStructVersion(n);
+
+            getDisplayConfig(topology, pathInfoV1, std::min(capacity, count));
+        } else if (version == NV_DISPLAYCONFIG_PATH_INFO_VER2) {
+            if (std::any_of(pathInfo, pathInfo + capacity, [](const auto& path) { return path.version != NV_DISPLAYCONFIG_PATH_INFO_VER2; }))
+                return IncompatibleStructVersion(n);
+
+            getDisplayConfig(topology, pathInfo, std::min(capacity, count));
+        } else
+            return IncompatibleStructVersion(n);
+
+        *pathInfoCount = count;
+
+        if (capacity < count)
+            return InsufficientBuffer(n);
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_DISP_GetTiming(NvU32 displayId, NV_TIMING_INPUT *timingInput, NV_TIMING *pTiming) {
+        constexpr auto n = "NvAPI_DISP_GetTiming";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (timingInput == nullptr || pTiming == nullptr)
+            return InvalidArgument(n);
+
+        if (timingInput->version != NV_TIMING_INPUT_VER)
+            return IncompatibleStructVersion(n);
+
+        // Only the current timing is looked up without a mode
+        if (timingInput->type != NV_TIMING_OVERRIDE_CURRENT && (timingInput->width == 0 || timingInput->height == 0))
+            return InvalidArgument(n);
+
+        auto output = nvapiAdapterRegistry->GetOutputById(displayId);
+        if (output == nullptr)
+            return InvalidDisplayId(str::format(n, " ", displayId));
+
+        // Timings are only known from the EDID, formula based types are served from there as well
+        const auto& mode = output->GetCurrentMode();
+        auto isCurrent = timingInput->type == NV_TIMING_OVERRIDE_CURRENT;
+        auto width = isCurrent ? mode.width : timingInput->width;
+        auto height = isCurrent ? mode.height : timingInput->height;
+        auto refreshRate1K = isCurrent ? mode.refreshRate * 1000 : static_cast<NvU32>(timingInput->rr * 1000.0f);
+
+        if (auto timing = findTiming(output->GetEdidInfo(), width, height, refreshRate1K); timing != nullptr) {
+            std::memcpy(pTiming, timing, sizeof(NV_TIMING));
+            return Ok(n, alreadyLogged);
+        }
+
+        // Unknown to the EDID, report the mode itself without any blanking
+        if (refreshRate1K == 0)
+            refreshRate1K = mode.refreshRate * 1000;
+
+        *pTiming = {};
+        pTiming->HVisible = pTiming->HTotal = static_cast<NvU16>(width);
+        pTiming->VVisible = pTiming->VTotal = static_cast<NvU16>(height);
+        pTiming->interlaced = isCurrent && mode.interlaced;
+        pTiming->pclk = static_cast<NvU32>(static_cast<uint64_t>(width) * height * refreshRate1K / 10000000);
+        pTiming->etc.rrx1k = refreshRate1K;
+        pTiming->etc.rr = static_cast<NvU16>((refreshRate1K + 500) / 1000);
+        pTiming->etc.rep = 1;
+        pTiming->etc.status = timingInput->type;
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_DISP_GetMonitorCapabilities(NvU32 displayId, NV_MONITOR_CAPABILITIES *pMonitorCapabilities) {
+        constexpr auto n = "NvAPI_DISP_GetMonitorCapabilities";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pMonitorCapabilities == nullptr)
+            return InvalidArgument(n);
+
+        if (pMonitorCapabilities->version != NV_MONITOR_CAPABILITIES_VER1)
+            return IncompatibleStructVersion(n);
+
+        auto output = nvapiAdapterRegistry->GetOutputById(displayId);
+        if (output == nullptr)
+            return InvalidDisplayId(str::format(n, " ", displayId));
+
+        const auto& edidInfo = output->GetEdidInfo();
+        pMonitorCapabilities->size = sizeof(NV_MONITOR_CAPABILITIES_V1);
+        pMonitorCapabilities->connectorType = edidInfo.connectorType;
+        pMonitorCapabilities->data = {};
+
+        switch (pMonitorCapabilities->infoType) {
+            case NV_MONITOR_CAPS_TYPE_HDMI_VSDB:
+                pMonitorCapabilities->bIsValidInfo = edidInfo.hasVsdb;
+                pMonitorCapabilities->data.vsdb = edidInfo.vsdb;
+                break;
+            case NV_MONITOR_CAPS_TYPE_HDMI_VCDB:
+                pMonitorCapabilities->bIsValidInfo = edidInfo.hasVcdb;
+                pMonitorCapabilities->data.vcdb = edidInfo.vcdb;
+                break;
+            default:
+                return InvalidArgument(str::format(n, " ", pMonitorCapabilities->infoType));
+        }
+
+        return Ok(str::format(n, " ", displayId));
+    }
 }
@@ -2,20 +2,217 @@
 #include "nvapi_static.h"
 #include "util/util_statuscode.h"
 
+namespace dxvk {
+    // Everything DXGI reports is attached to the desktop, thus connected and active
+    static NvAPI_Status getDisplayIds(const std::string& n, const NvapiAdapterRegistry* nvapiAdapterRegistry, NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_DISPLAYIDS* pDisplayIds, NvU32* pDisplayIdCount) {
+        if (hPhysicalGpu == nullptr || pDisplayIdCount == nullptr)
+            return InvalidArgument(n);
+
+        auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGpu);
+        if (index == -1)
+            return ExpectedPhysicalGpuHandle(n);
+
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto capacity = *pDisplayIdCount;
+        auto count = 0U;
+        for (auto i = 0U; i < topology->GetOutputCount(); i++) {
+            if (topology->GetOutputParent(i) == index)
+                count++;
+        }
+
+        // Validate every element that is going to be written before touching any of them
+        if (pDisplayIds != nullptr && std::any_of(pDisplayIds, pDisplayIds + std::min(capacity, count),
+                [](const auto& displayIds) { return displayIds.version != NV_GPU_DISPLAYIDS_VER1 && displayIds.version != NV_GPU_DISPLAYIDS_VER2; }))
+            return IncompatibleStructVersion(n);
+
+        for (auto i = 0U, j = 0U; pDisplayIds != nullptr && i < topology->GetOutputCount() && j < capacity; i++) {
+            if (topology->GetOutputParent(i) != index)
+                continue;
+
+            auto& displayIds = pDisplayIds[j++];
+            auto version = displayIds.version;
+            displayIds = {};
+            displayIds.version = version;
+            displayIds.connectorType = topology->GetOutput(i)->GetEdidInfo().connectorType;
+            displayIds.displayId = topology->GetOutputId(i);
+            displayIds.isActive = true;
+            displayIds.isOSVisible = true;
+            displayIds.isConnected = true;
+            displayIds.isPhysicallyConnected = true;
+        }
+
+        *pDisplayIdCount = count;
+
+        if (pDisplayIds != nullptr && capacity < count)
+            return InsufficientBuffer(n);
+
+        return Ok(n);
+    }
+
+    // Masks are built with the topology snapshot, DXGI only enumerates outputs attached to the desktop
+    static NvAPI_Status getOutputsMask(const std::string& n, const NvapiAdapterRegistry* nvapiAdapterRegistry, NvPhysicalGpuHandle hPhysicalGpu, NvU32* pOutputsMask) {
+        if (hPhysicalGpu == nullptr || pOutputsMask == nullptr)
+            return InvalidArgument(n);
+
+        auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGpu);
+        if (index == -1)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pOutputsMask = nvapiAdapterRegistry->GetTopology()->GetOutputsMask(index);
+
+        return Ok(n);
+    }
+}
+
 extern "C" {
     using namespace dxvk;
 
+    NvAPI_Status __cdecl NvAPI_GPU_GetConnectedDisplayIds(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_DISPLAYIDS* pDisplayIds, NvU32* pDisplayIdCount, NvU32 flags) {
+        constexpr auto n = "NvAPI_GPU_GetConnectedDisplayIds";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        return getDisplayIds(n, nvapiAdapterRegistry.get(), hPhysicalGpu, pDisplayIds, pDisplayIdCount);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetAllDisplayIds(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_DISPLAYIDS* pDisplayIds, NvU32* pDisplayIdCount) {
+        constexpr auto n = "NvAPI_GPU_GetAllDisplayIds";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        // DXGI cannot see disconnected connectors, report the same as for connected displays
+        return getDisplayIds(n, nvapiAdapterRegistry.get(), hPhysicalGpu, pDisplayIds, pDisplayIdCount);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetAllOutputs(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pOutputsMask) {
+        constexpr auto n = "NvAPI_GPU_GetAllOutputs";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        // Disconnected connectors are unknown, report the same as for connected outputs
+        return getOutputsMask(n, nvapiAdapterRegistry.get(), hPhysicalGpu, pOutputsMask);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetConnectedOutputs(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pOutputsMask) {
+        constexpr auto n = "NvAPI_GPU_GetConnectedOutputs";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        return getOutputsMask(n, nvapiAdapterRegistry.get(), hPhysicalGpu, pOutputsMask);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetActiveOutputs(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pOutputsMask) {
+        constexpr auto n = "NvAPI_GPU_GetActiveOutputs";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        return getOutputsMask(n, nvapiAdapterRegistry.get(), hPhysicalGpu, pOutputsMask);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetOutputType(NvPhysicalGpuHandle hPhysicalGpu, NvU32 outputId, NV_GPU_OUTPUT_TYPE *pOutputType) {
+        constexpr auto n = "NvAPI_GPU_GetOutputType";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (outputId == 0 || pOutputType == nullptr)
+            return InvalidArgument(n);
+
+        // Either a display ID, or an output ID of the given GPU
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto displayId = outputId;
+        if ((outputId & NvapiTopology::displayIdBase) == 0) {
+            if (hPhysicalGpu == nullptr)
+                return InvalidArgument(n);
+
+            auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGpu);
+            if (index == -1)
+                return ExpectedPhysicalGpuHandle(n);
+
+            displayId = topology->GetOutputId(index, outputId);
+        }
+
+        auto index = topology->GetOutputIndex(displayId);
+        if (index == -1)
+            return InvalidArgument(str::format(n, " ", outputId));
+
+        *pOutputType = topology->GetOutputType(index);
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetEDID(NvPhysicalGpuHandle hPhysicalGpu, NvU32 displayOutputId, NV_EDID *pEDID) {
+        constexpr auto n = "NvAPI_GPU_GetEDID";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pEDID == nullptr)
+            return InvalidArgument(n);
+
+        if (pEDID->version != NV_EDID_VER1 && pEDID->version != NV_EDID_VER2 && pEDID->version != NV_EDID_VER3)
+            return IncompatibleStructVersion(n);
+
+        auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGpu);
+        if (index == -1)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Either a display ID of the given GPU, or one of its output IDs
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto displayId = displayOutputId;
+        if ((displayOutputId & NvapiTopology::displayIdBase) == 0)
+            displayId = topology->GetOutputId(index, displayOutputId);
+
+        auto outputIndex = topology->GetOutputIndex(displayId);
+        if (outputIndex == -1 || topology->GetOutputParent(outputIndex) != index)
+            return InvalidArgument(str::format(n, " ", displayOutputId));
+
+        const auto& edid = topology->GetOutput(outputIndex)->GetEdid();
+        if (edid.empty())
+            return DataNotFound(str::format(n, " ", displayOutputId));
+
+        // Version 3 reads larger EDIDs in pages of NV_EDID_DATA_SIZE bytes
+        auto offset = pEDID->version == NV_EDID_VER3 ? pEDID->offset : 0U;
+        if (offset >= edid.size())
+            return InvalidArgument(str::format(n, " ", displayOutputId, " offset ", offset));
+
+        auto size = std::min<size_t>(edid.size() - offset, NV_EDID_DATA_SIZE);
+        std::memset(pEDID->EDID_Data, 0, sizeof(pEDID->EDID_Data));
+        std::memcpy(pEDID->EDID_Data, edid.data() + offset, size);
+
+        if (pEDID->version != NV_EDID_VER1)
+            pEDID->sizeofEDID = static_cast<NvU32>(edid.size());
+
+        if (pEDID->version == NV_EDID_VER3)
+            pEDID->edidId = topology->GetOutput(outputIndex)->GetEdidInfo().id;
+
+        return Ok(str::format(n, " ", displayOutputId));
+    }
+
     NvAPI_Status __cdecl NvAPI_GPU_GetGPUType(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_TYPE *pGpuType) {
         constexpr auto n = "NvAPI_GPU_GetGPUType";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (hPhysicalGpu == nullptr || pGpuType == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         *pGpuType = (NV_GPU_TYPE) adapter->GetGpuType();
@@ -26,20 +223,23 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GPU_GetPCIIdentifiers(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pDeviceId, NvU32 *pSubSystemId, NvU32 *pRevisionId, NvU32 *pExtDeviceId) {
         constexpr auto n = "NvAPI_GPU_GetPCIIdentifiers";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (hPhysicalGpu == nullptr || pDeviceId == nullptr || pSubSystemId == nullptr || pRevisionId == nullptr || pExtDeviceId == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
+        const auto& pciInfo = adapter->GetPciInfo();
+
         *pDeviceId = adapter->GetDeviceId();
-        *pSubSystemId = 0;
-        *pRevisionId = 0;
-        *pExtDeviceId = 0;
+        *pSubSystemId = pciInfo.subSystemId;
+        *pRevisionId = pciInfo.revisionId;
+        *pExtDeviceId = pciInfo.extDeviceId;
 
         return Ok(n);
     }
@@ -47,14 +247,15 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GPU_GetFullName(NvPhysicalGpuHandle hPhysicalGpu, NvAPI_ShortString szName) {
         constexpr auto n = "NvAPI_GPU_GetFullName";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (hPhysicalGpu == nullptr || szName == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         strcpy(szName, adapter->GetDeviceName().c_str());
@@ -65,14 +266,15 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GPU_GetBusId(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pBusId) {
         constexpr auto n = "NvAPI_GPU_GetBusId";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (hPhysicalGpu == nullptr || pBusId == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         *pBusId = adapter->GetBusId();
@@ -80,17 +282,164 @@ extern "C" {
         return Ok(n);
     }
 
+    NvAPI_Status __cdecl NvAPI_GPU_GetBusType(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_BUS_TYPE *pBusType) {
+        constexpr auto n = "NvAPI_GPU_GetBusType";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pBusType == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pBusType = adapter->GetPciInfo().busType;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetBusSlotId(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pBusSlotId) {
+        constexpr auto n = "NvAPI_GPU_GetBusSlotId";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pBusSlotId == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Only known when set through DXVK_NVAPI_PCI_OVERRIDE
+        const auto& pciInfo = adapter->GetPciInfo();
+        if (pciInfo.busSlotId == 0)
+            return NotSupported(n);
+
+        *pBusSlotId = pciInfo.busSlotId;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetCurrentPCIEDownstreamWidth(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pWidth) {
+        constexpr auto n = "NvAPI_GPU_GetCurrentPCIEDownstreamWidth";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pWidth == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Only known when set through DXVK_NVAPI_PCI_OVERRIDE
+        const auto& pciInfo = adapter->GetPciInfo();
+        if (pciInfo.busType != NVAPI_GPU_BUS_TYPE_PCI_EXPRESS || pciInfo.pcieWidth == 0)
+            return NotSupported(n);
+
+        *pWidth = pciInfo.pcieWidth;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetVbiosVersionString(NvPhysicalGpuHandle hPhysicalGpu, NvAPI_ShortString szBiosRevision) {
+        constexpr auto n = "NvAPI_GPU_GetVbiosVersionString";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || szBiosRevision == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        strcpy(szBiosRevision, adapter->GetBoardInfo().vbiosVersion);
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetBoardInfo(NvPhysicalGpuHandle hPhysicalGpu, NV_BOARD_INFO *pBoardInfo) {
+        constexpr auto n = "NvAPI_GPU_GetBoardInfo";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pBoardInfo == nullptr)
+            return InvalidArgument(n);
+
+        if (pBoardInfo->version != NV_BOARD_INFO_VER1)
+            return IncompatibleStructVersion(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        std::memcpy(pBoardInfo->BoardNum, adapter->GetBoardInfo().boardNumber, sizeof(pBoardInfo->BoardNum));
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetSystemType(NvPhysicalGpuHandle hPhysicalGpu, NV_SYSTEM_TYPE *pSystemType) {
+        constexpr auto n = "NvAPI_GPU_GetSystemType";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pSystemType == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pSystemType = adapter->GetBoardInfo().systemType;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetQuadroStatus(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pStatus) {
+        constexpr auto n = "NvAPI_GPU_GetQuadroStatus";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pStatus == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pStatus = adapter->GetBoardInfo().isQuadro ? 1 : 0;
+
+        return Ok(n);
+    }
+
     NvAPI_Status __cdecl NvAPI_GPU_GetPhysicalFrameBufferSize(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pSize) {
         constexpr auto n = "NvAPI_GPU_GetPhysicalFrameBufferSize";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (pSize == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         *pSize = adapter->GetVRamSize();
@@ -98,17 +447,300 @@ extern "C" {
         return Ok(n);
     }
 
+    NvAPI_Status __cdecl NvAPI_GPU_GetVirtualFrameBufferSize(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pSize) {
+        constexpr auto n = "NvAPI_GPU_GetVirtualFrameBufferSize";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pSize == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        *pSize = adapter->GetVirtualFrameBufferSize();
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetMemoryInfo(NvPhysicalGpuHandle hPhysicalGpu, NV_DISPLAY_DRIVER_MEMORY_INFO *pMemoryInfo) {
+        constexpr auto n = "NvAPI_GPU_GetMemoryInfo";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || pMemoryInfo == nullptr)
+            return InvalidArgument(n);
+
+        if (pMemoryInfo->version != NV_DISPLAY_DRIVER_MEMORY_INFO_VER_1 && pMemoryInfo->version != NV_DISPLAY_DRIVER_MEMORY_INFO_VER_2 && pMemoryInfo->version != NV_DISPLAY_DRIVER_MEMORY_INFO_VER_3)
+            return IncompatibleStructVersion(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // All sizes in KB, there is no driver reserved system memory and no eviction statistics
+        auto budget = adapter->GetMemoryBudget();
+        auto available = static_cast<NvU32>((budget.budget > budget.usage ? budget.budget - budget.usage : 0) / 1024);
+
+        pMemoryInfo->dedicatedVideoMemory = adapter->GetVRamSize();
+        pMemoryInfo->availableDedicatedVideoMemory = adapter->GetVRamSize();
+        pMemoryInfo->systemVideoMemory = 0;
+        pMemoryInfo->sharedSystemMemory = adapter->GetSharedSystemMemorySize();
+
+        if (pMemoryInfo->version != NV_DISPLAY_DRIVER_MEMORY_INFO_VER_1)
+            pMemoryInfo->curAvailableDedicatedVideoMemory = available;
+
+        if (pMemoryInfo->version == NV_DISPLAY_DRIVER_MEMORY_INFO_VER_3) {
+            pMemoryInfo->dedicatedVideoMemoryEvictionsSize = 0;
+            pMemoryInfo->dedicatedVideoMemoryEvictionCount = 0;
+        }
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetDynamicPstatesInfoEx(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_DYNAMIC_PSTATES_INFO_EX *pDynamicPstatesInfoEx) {
+        constexpr auto n = "NvAPI_GPU_GetDynamicPstatesInfoEx";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pDynamicPstatesInfoEx == nullptr)
+            return InvalidArgument(n);
+
+        if (pDynamicPstatesInfoEx->version != NV_GPU_DYNAMIC_PSTATES_INFO_EX_VER)
+            return IncompatibleStructVersion(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        NvapiTelemetrySample sample;
+        if (!adapter->GetTelemetry(sample) || !sample.Has(NvapiTelemetryField::Utilization))
+            return NotSupported(n, alreadyLogged);
+
+        // Utilization domains are GPU, frame buffer, video engine and bus interface, in that order
+        const NvU32 percentages[] = {sample.gpuUtilization, sample.memoryUtilization, sample.videoUtilization, sample.busUtilization};
+
+        pDynamicPstatesInfoEx->flags = 1;
+        for (auto i = 0U; i < NVAPI_MAX_GPU_UTILIZATIONS; i++) {
+            auto present = i < std::size(percentages) && (i != 3 || sample.Has(NvapiTelemetryField::BusUtilization));
+            pDynamicPstatesInfoEx->utilization[i].bIsPresent = present;
+            pDynamicPstatesInfoEx->utilization[i].percentage = present ? percentages[i] : 0;
+        }
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetCurrentPstate(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_PERF_PSTATE_ID *pCurrentPstate) {
+        constexpr auto n = "NvAPI_GPU_GetCurrentPstate";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pCurrentPstate == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        NvapiTelemetrySample sample;
+        if (!adapter->GetTelemetry(sample) || !sample.Has(NvapiTelemetryField::Pstate) || sample.pstate > NVAPI_GPU_PERF_PSTATE_P15)
+            return NotSupported(n, alreadyLogged);
+
+        *pCurrentPstate = static_cast<NV_GPU_PERF_PSTATE_ID>(sample.pstate);
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetAllClockFrequencies(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_CLOCK_FREQUENCIES *pClkFreqs) {
+        constexpr auto n = "NvAPI_GPU_GetAllClockFrequencies";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pClkFreqs == nullptr)
+            return InvalidArgument(n);
+
+        if (pClkFreqs->version != NV_GPU_CLOCK_FREQUENCIES_VER_1 && pClkFreqs->version != NV_GPU_CLOCK_FREQUENCIES_VER_2 && pClkFreqs->version != NV_GPU_CLOCK_FREQUENCIES_VER_3)
+            return IncompatibleStructVersion(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Version 1 has no clock type and always reports current clocks
+        NvU32 clockType = pClkFreqs->version == NV_GPU_CLOCK_FREQUENCIES_VER_1
+            ? static_cast<NvU32>(NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ)
+            : pClkFreqs->ClockType;
+
+        NvapiTelemetrySample sample;
+        if (!adapter->GetTelemetry(sample))
+            return NotSupported(n, alreadyLogged);
+
+        NvU32 graphicsClock = 0, memoryClock = 0, videoClock = 0;
+        switch (clockType) {
+            case NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ:
+                if (!sample.Has(NvapiTelemetryField::Clocks))
+                    return NotSupported(n, alreadyLogged);
+
+                graphicsClock = sample.graphicsClock;
+                memoryClock = sample.memoryClock;
+                videoClock = sample.videoClock;
+                break;
+            case NV_GPU_CLOCK_FREQUENCIES_BASE_CLOCK:
+                if (!sample.Has(NvapiTelemetryField::BaseClocks))
+                    return NotSupported(n, alreadyLogged);
+
+                graphicsClock = sample.baseGraphicsClock;
+                memoryClock = sample.baseMemoryClock;
+                break;
+            case NV_GPU_CLOCK_FREQUENCIES_BOOST_CLOCK:
+                if (!sample.Has(NvapiTelemetryField::BoostClocks))
+                    return NotSupported(n, alreadyLogged);
+
+                graphicsClock = sample.boostGraphicsClock;
+                memoryClock = sample.boostMemoryClock;
+                break;
+            default:
+                return InvalidArgument(n);
+        }
+
+        for (auto& domain : pClkFreqs->domain) {
+            domain.bIsPresent = 0;
+            domain.frequency = 0;
+        }
+
+        pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].bIsPresent = 1;
+        pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency = graphicsClock;
+        pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].bIsPresent = 1;
+        pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency = memoryClock;
+
+        if (videoClock != 0) {
+            pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_VIDEO].bIsPresent = 1;
+            pClkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_VIDEO].frequency = videoClock;
+        }
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetThermalSettings(NvPhysicalGpuHandle hPhysicalGpu, NvU32 sensorIndex, NV_GPU_THERMAL_SETTINGS *pThermalSettings) {
+        constexpr auto n = "NvAPI_GPU_GetThermalSettings";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pThermalSettings == nullptr)
+            return InvalidArgument(n);
+
+        if (pThermalSettings->version != NV_GPU_THERMAL_SETTINGS_VER_1 && pThermalSettings->version != NV_GPU_THERMAL_SETTINGS_VER_2)
+            return IncompatibleStructVersion(n);
+
+        // Only the GPU core sensor is known
+        if (sensorIndex != 0 && sensorIndex != NVAPI_THERMAL_TARGET_ALL)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        NvapiTelemetrySample sample;
+        if (!adapter->GetTelemetry(sample) || !sample.Has(NvapiTelemetryField::Temperature))
+            return NotSupported(n, alreadyLogged);
+
+        // Both versions share the layout, version 1 just cannot report temperatures below zero
+        auto isVersion1 = pThermalSettings->version == NV_GPU_THERMAL_SETTINGS_VER_1;
+        auto clamp = [isVersion1](NvS32 temperature) { return isVersion1 ? std::max(temperature, 0) : temperature; };
+
+        pThermalSettings->count = 1;
+        pThermalSettings->sensor[0].controller = NVAPI_THERMAL_CONTROLLER_GPU_INTERNAL;
+        pThermalSettings->sensor[0].defaultMinTemp = 0;
+        pThermalSettings->sensor[0].defaultMaxTemp = clamp(sample.gpuMaxTemperature);
+        pThermalSettings->sensor[0].currentTemp = clamp(sample.gpuTemperature);
+        pThermalSettings->sensor[0].target = NVAPI_THERMAL_TARGET_GPU;
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetPerfDecreaseInfo(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pPerfDecrInfo) {
+        constexpr auto n = "NvAPI_GPU_GetPerfDecreaseInfo";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pPerfDecrInfo == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        NvapiTelemetrySample sample;
+        if (!adapter->GetTelemetry(sample) || !sample.Has(NvapiTelemetryField::PerfDecrease))
+            return NotSupported(n, alreadyLogged);
+
+        *pPerfDecrInfo = sample.perfDecreaseReasons;
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetLogicalGpuInfo(NvLogicalGpuHandle hLogicalGpu, NV_LOGICAL_GPU_DATA *pLogicalGpuData) {
+        constexpr auto n = "NvAPI_GPU_GetLogicalGpuInfo";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hLogicalGpu == nullptr || pLogicalGpuData == nullptr || pLogicalGpuData->pOSAdapterId == nullptr)
+            return InvalidArgument(n);
+
+        if (pLogicalGpuData->version != NV_LOGICAL_GPU_DATA_VER1)
+            return IncompatibleStructVersion(n);
+
+        auto index = nvapiAdapterRegistry->GetLogicalGpuIndex(hLogicalGpu);
+        if (index == -1)
+            return ExpectedLogicalGpuHandle(n);
+
+        // Physical GPUs are listed in node order, all of them share the LUID of the first one
+        const auto& adapters = nvapiAdapterRegistry->GetLogicalGpuAdapters(index);
+        if (!nvapiAdapterRegistry->GetAdapter(adapters.front())->GetLUID(static_cast<LUID*>(pLogicalGpuData->pOSAdapterId)))
+            return Error(n);
+
+        for (auto i = 0U; i < adapters.size(); i++)
+            pLogicalGpuData->physicalGpuHandles[i] = nvapiAdapterRegistry->GetPhysicalGpuHandle(adapters[i]);
+
+        pLogicalGpuData->physicalGpuCount = adapters.size();
+
+        return Ok(n);
+    }
+
     NvAPI_Status __cdecl NvAPI_GPU_GetAdapterIdFromPhysicalGpu(NvPhysicalGpuHandle hPhysicalGpu, void *pOSAdapterId) {
         constexpr auto n = "NvAPI_GPU_GetAdapterIdFromPhysicalGpu";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (pOSAdapterId == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         if (!adapter->GetLUID(static_cast<LUID*>(pOSAdapterId)))
@@ -120,14 +752,15 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_GPU_GetArchInfo(NvPhysicalGpuHandle hPhysicalGpu, NV_GPU_ARCH_INFO *pGpuArchInfo) {
         constexpr auto n = "NvAPI_GPU_GetArchInfo";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
         if (pGpuArchInfo == nullptr)
             return InvalidArgument(n);
 
-        auto adapter = reinterpret_cast<NvapiAdapter*>(hPhysicalGpu);
-        if (!nvapiAdapterRegistry->IsAdapter(adapter))
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
             return ExpectedPhysicalGpuHandle(n);
 
         if (pGpuArchInfo->version != NV_GPU_ARCH_INFO_VER_1 && pGpuArchInfo->version != NV_GPU_ARCH_INFO_VER_2)
@@ -136,36 +769,59 @@ extern "C" {
         if (adapter->GetDriverId() != VK_DRIVER_ID_NVIDIA_PROPRIETARY)
             return NvidiaDeviceNotFound(n);
 
-        pGpuArchInfo->architecture_id = adapter->GetArchitectureId();
+        const auto& archInfo = adapter->GetArchInfo();
 
-        // Assume the implementation ID from the architecture ID. No simple way
-        // to do a more fine-grained query at this time. Would need wine-nvml
-        // usage.
-        switch(pGpuArchInfo->architecture_id) {
-            case NV_GPU_ARCHITECTURE_GK100:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_GK104;
-                break;
-            case NV_GPU_ARCHITECTURE_GM200:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_GM204;
-                break;
-            case NV_GPU_ARCHITECTURE_GP100:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_GP102;
-                break;
-            case NV_GPU_ARCHITECTURE_GV100:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_GV100;
-                break;
-            case NV_GPU_ARCHITECTURE_TU100:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_TU102;
-                break;
-            case NV_GPU_ARCHITECTURE_GA100:
-                pGpuArchInfo->implementation_id = NV_GPU_ARCH_IMPLEMENTATION_GA102;
-                break;
-            default:
-                return Error(n);
-        }
+        pGpuArchInfo->architecture_id = archInfo.architecture;
+        pGpuArchInfo->implementation_id = archInfo.implementation;
+        pGpuArchInfo->revision_id = archInfo.revision;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetGpuCoreCount(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pCount) {
+        constexpr auto n = "NvAPI_GPU_GetGpuCoreCount";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pCount == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Needs VK_NV_shader_sm_builtins
+        auto count = adapter->GetGpuCoreCount();
+        if (count == 0)
+            return NotSupported(n);
+
+        *pCount = count;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_GPU_GetShaderSubPipeCount(NvPhysicalGpuHandle hPhysicalGpu, NvU32 *pCount) {
+        constexpr auto n = "NvAPI_GPU_GetShaderSubPipeCount";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pCount == nullptr)
+            return InvalidArgument(n);
+
+        auto adapter = nvapiAdapterRegistry->GetAdapter(hPhysicalGpu);
+        if (adapter == nullptr)
+            return ExpectedPhysicalGpuHandle(n);
+
+        // Needs VK_NV_shader_sm_builtins
+        auto count = adapter->GetShaderSubPipeCount();
+        if (count == 0)
+            return NotSupported(n);
 
-        // Assume first revision, no way to query currently.
-        pGpuArchInfo->revision_id = NV_GPU_CHIP_REV_A01;
+        *pCount = count;
 
         return Ok(n);
     }
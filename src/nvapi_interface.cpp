@@ -46,23 +46,60 @@ extern "C" {
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_D3D_GetObjectHandleForResource)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_D3D_SetResourceHint)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_D3D_GetCurrentSLIState)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_D3D_IsGSyncCapable)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_D3D_IsGSyncActive)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetConnectedDisplayIds)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetAllDisplayIds)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetAllOutputs)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetConnectedOutputs)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetActiveOutputs)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetOutputType)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetEDID)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetGPUType)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetPCIIdentifiers)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetFullName)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetBusId)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetBusType)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetBusSlotId)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetCurrentPCIEDownstreamWidth)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetVbiosVersionString)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetBoardInfo)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetSystemType)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetQuadroStatus)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetPhysicalFrameBufferSize)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetVirtualFrameBufferSize)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetMemoryInfo)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetDynamicPstatesInfoEx)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetCurrentPstate)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetAllClockFrequencies)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetThermalSettings)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetPerfDecreaseInfo)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetLogicalGpuInfo)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetAdapterIdFromPhysicalGpu)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetArchInfo)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetGpuCoreCount)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GPU_GetShaderSubPipeCount)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_Disp_GetHdrCapabilities)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetDisplayIdByDisplayName)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetGDIPrimaryDisplayId)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetAdaptiveSyncData)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetDisplayConfig)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetTiming)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_DISP_GetMonitorCapabilities)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_Mosaic_GetCurrentTopo)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_Mosaic_EnumDisplayGrids)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_Mosaic_GetDisplayViewportsByResolution)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_SYS_GetPhysicalGpuFromDisplayId)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_SYS_GetDisplayIdFromGpuAndOutputId)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_SYS_GetGpuAndOutputIdFromDisplayId)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_SYS_GetDriverAndBranchVersion)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_EnumLogicalGPUs)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_EnumPhysicalGPUs)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetDisplayDriverVersion)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetPhysicalGPUsFromDisplay)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetLogicalGPUFromDisplay)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetLogicalGPUFromPhysicalGPU)
+        INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetPhysicalGPUsFromLogicalGPU)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_EnumNvidiaDisplayHandle)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_EnumNvidiaUnAttachedDisplayHandle)
         INSERT_AND_RETURN_WHEN_EQUALS(NvAPI_GetInterfaceVersionString)
@@ -1,10 +1,190 @@
 #include "nvapi_private.h"
+#include "nvapi_static.h"
 #include "util/util_statuscode.h"
+#include "util/util_string.h"
+
+namespace dxvk {
+    template<typename GridTopo>
+    static void enumDisplayGrids(const NvapiTopology* topology, GridTopo* gridTopologies, const NvU32 gridCount) {
+        const auto& grids = topology->GetDisplayGrids();
+        for (auto i = 0U; i < gridCount; i++) {
+            const auto& grid = grids[i];
+            auto& gridTopo = gridTopologies[i];
+            auto version = gridTopo.version;
+            gridTopo = {};
+            gridTopo.version = version;
+            gridTopo.rows = grid.rows;
+            gridTopo.columns = grid.columns;
+            gridTopo.displayCount = grid.outputs.size();
+            gridTopo.applyWithBezelCorrect = grid.overlapX != 0 || grid.overlapY != 0;
+
+            for (auto j = 0U; j < grid.outputs.size(); j++) {
+                auto& display = gridTopo.displays[j];
+                if constexpr (std::is_same_v<GridTopo, NV_MOSAIC_GRID_TOPO_V2>)
+                    display.version = MAKE_NVAPI_VERSION(NV_MOSAIC_GRID_TOPO_DISPLAY_V2, 1);
+
+                display.displayId = topology->GetOutputId(grid.outputs[j]);
+                display.overlapX = grid.overlapX;
+                display.overlapY = grid.overlapY;
+                display.rotation = topology->GetTargetInfo(grid.outputs[j]).rotation;
+            }
+
+            const auto& mode = topology->GetOutput(grid.outputs[0])->GetCurrentMode();
+            gridTopo.displaySettings.version = NVAPI_MOSAIC_DISPLAY_SETTING_VER1;
+            gridTopo.displaySettings.width = mode.width;
+            gridTopo.displaySettings.height = mode.height;
+            gridTopo.displaySettings.bpp = mode.bitsPerPixel;
+            gridTopo.displaySettings.freq = mode.refreshRate;
+        }
+    }
+}
 
 extern "C" {
     using namespace dxvk;
 
+    NvAPI_Status __cdecl NvAPI_Mosaic_GetCurrentTopo(NV_MOSAIC_TOPO_BRIEF* pTopoBrief, NV_MOSAIC_DISPLAY_SETTING* pDisplaySetting, NvS32* pOverlapX, NvS32* pOverlapY) {
+        constexpr auto n = "NvAPI_Mosaic_GetCurrentTopo";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pTopoBrief == nullptr || pDisplaySetting == nullptr || pOverlapX == nullptr || pOverlapY == nullptr)
+            return InvalidArgument(n);
+
+        if (pTopoBrief->version != NVAPI_MOSAIC_TOPO_BRIEF_VER)
+            return IncompatibleStructVersion(n);
+
+        if (pDisplaySetting->version != NVAPI_MOSAIC_DISPLAY_SETTING_VER1 && pDisplaySetting->version != NVAPI_MOSAIC_DISPLAY_SETTING_VER2)
+            return IncompatibleStructVersion(n);
+
+        // Without a grid there is no current topology, which is not an error
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto grid = topology->GetMosaicGrid();
+        pTopoBrief->topo = grid != nullptr ? grid->topo : NV_MOSAIC_TOPO_NONE;
+        pTopoBrief->enabled = grid != nullptr;
+        pTopoBrief->isPossible = grid != nullptr;
+        *pOverlapX = grid != nullptr ? grid->overlapX : 0;
+        *pOverlapY = grid != nullptr ? grid->overlapY : 0;
+
+        NvapiOutputMode mode{};
+        if (grid != nullptr)
+            mode = topology->GetOutput(grid->outputs[0])->GetCurrentMode();
+
+        pDisplaySetting->width = mode.width;
+        pDisplaySetting->height = mode.height;
+        pDisplaySetting->bpp = mode.bitsPerPixel;
+        pDisplaySetting->freq = mode.refreshRate;
+        if (pDisplaySetting->version == NVAPI_MOSAIC_DISPLAY_SETTING_VER2)
+            pDisplaySetting->rrx1k = mode.refreshRate * 1000;
+
+        return Ok(n, alreadyLogged);
+    }
+
+    NvAPI_Status __cdecl NvAPI_Mosaic_EnumDisplayGrids(NV_MOSAIC_GRID_TOPO* pGridTopologies, NvU32* pGridCount) {
+        constexpr auto n = "NvAPI_Mosaic_EnumDisplayGrids";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (pGridCount == nullptr || (pGridTopologies != nullptr && *pGridCount == 0))
+            return InvalidArgument(n);
+
+        // Displays outside of the Mosaic grid are reported as grids of their own
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto count = static_cast<NvU32>(topology->GetDisplayGrids().size());
+        if (pGridTopologies == nullptr) {
+            *pGridCount = count;
+            return Ok(n, alreadyLogged);
+        }
+
+        // Version 1 displays are smaller, all elements have to agree on the layout
+        auto capacity = *pGridCount;
+        auto version = pGridTopologies[0].version;
+        if (version == NV_MOSAIC_GRID_TOPO_VER1) {
+            auto gridTopologiesV1 = reinterpret_cast<NV_MOSAIC_GRID_TOPO_V1*>(pGridTopologies);
+            if (std::any_of(gridTopologiesV1, gridTopologiesV1 + capacity, [](const auto& grid) { return grid.version != NV_MOSAIC_GRID_TOPO_VER1; }))
+                return IncompatibleStructVersion(n);
+
+            enumDisplayGrids(topology, gridTopologiesV1, std::min(capacity, count));
+        } else if (version == NV_MOSAIC_GRID_TOPO_VER2) {
+            if (std::any_of(pGridTopologies, pGridTopologies + capacity, [](const auto& grid) { return grid.version != NV_MOSAIC_GRID_TOPO_VER2; }))
+                return IncompatibleStructVersion(n);
+
+            enumDisplayGrids(topology, pGridTopologies, std::min(capacity, count));
+        } else
+            return IncompatibleStructVersion(n);
+
+        *pGridCount = count;
+
+        if (capacity < count)
+            return InsufficientBuffer(n);
+
+        return Ok(n, alreadyLogged);
+    }
+
     NvAPI_Status __cdecl NvAPI_Mosaic_GetDisplayViewportsByResolution(NvU32 displayId, NvU32 srcWidth, NvU32 srcHeight, NV_RECT viewports[NV_MOSAIC_MAX_DISPLAYS], NvU8* bezelCorrected) {
-        return MosaicNotActive("NvAPI_Mosaic_GetDisplayViewportsByResolution");
+        constexpr auto n = "NvAPI_Mosaic_GetDisplayViewportsByResolution";
+        static bool alreadyLogged = false;
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (viewports == nullptr)
+            return InvalidArgument(n);
+
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto grid = topology->GetMosaicGrid();
+        auto index = topology->GetOutputIndex(displayId);
+        if (grid == nullptr || index == -1 || std::find(grid->outputs.begin(), grid->outputs.end(), index) == grid->outputs.end())
+            return MosaicNotActive(n);
+
+        // The emulated desktop is bezel corrected, a gap hides pixels between displays while an overlap shows them twice
+        const auto& mode = topology->GetOutput(grid->outputs[0])->GetCurrentMode();
+        auto width = mode.width;
+        auto height = mode.height;
+        auto correctedWidth = grid->columns * width - (grid->columns - 1) * grid->overlapX;
+        auto correctedHeight = grid->rows * height - (grid->rows - 1) * grid->overlapY;
+        if (srcWidth == 0 && srcHeight == 0) {
+            srcWidth = correctedWidth;
+            srcHeight = correctedHeight;
+        }
+
+        std::fill(viewports, viewports + NV_MOSAIC_MAX_DISPLAYS, NV_RECT{});
+
+        // A single-wide resolution is shown on one display only, viewport bounds are inclusive
+        if (srcWidth == width && srcHeight == height) {
+            viewports[0] = {0, 0, width - 1, height - 1};
+            if (bezelCorrected != nullptr)
+                *bezelCorrected = 0;
+
+            return Ok(n, alreadyLogged);
+        }
+
+        // Any other resolution is stretched across the uncorrected grid
+        auto corrected = (grid->overlapX != 0 || grid->overlapY != 0) && srcWidth == correctedWidth && srcHeight == correctedHeight;
+        auto stepX = corrected ? width - grid->overlapX : width;
+        auto stepY = corrected ? height - grid->overlapY : height;
+        auto totalWidth = corrected ? correctedWidth : grid->columns * width;
+        auto totalHeight = corrected ? correctedHeight : grid->rows * height;
+        auto scale = [](uint64_t value, uint32_t size, uint32_t total) { return static_cast<NvU32>(value * size / total); };
+
+        for (auto i = 0U; i < grid->outputs.size(); i++) {
+            auto left = (i % grid->columns) * stepX;
+            auto top = (i / grid->columns) * stepY;
+            viewports[i].left = scale(left, srcWidth, totalWidth);
+            viewports[i].top = scale(top, srcHeight, totalHeight);
+            viewports[i].right = scale(left + width, srcWidth, totalWidth) - 1;
+            viewports[i].bottom = scale(top + height, srcHeight, totalHeight) - 1;
+        }
+
+        if (bezelCorrected != nullptr)
+            *bezelCorrected = corrected;
+
+        return Ok(n, alreadyLogged);
     }
 }
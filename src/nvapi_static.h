@@ -1,5 +1,7 @@
 #pragma once
 
 #include "sysinfo/nvapi_adapter_registry.h"
+#include "util/util_rcu.h"
 
-static dxvk::NvapiAdapterRegistry* nvapiAdapterRegistry = nullptr;
+// Entry points acquire a guarded reference, NvAPI_Unload frees the registry only after all of them have left
+static dxvk::rcu::Pointer<dxvk::NvapiAdapterRegistry> publishedAdapterRegistry;
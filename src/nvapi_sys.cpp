@@ -1,6 +1,7 @@
 #include "nvapi_private.h"
 #include "nvapi_static.h"
 #include "util/util_statuscode.h"
+#include "util/util_string.h"
 #include "../version.h"
 
 extern "C" {
@@ -9,14 +10,62 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_SYS_GetPhysicalGpuFromDisplayId(NvU32 displayId, NvPhysicalGpuHandle *hPhysicalGpu) {
         constexpr auto n = "NvAPI_SYS_GetPhysicalGpuFromDisplayId";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
-        auto output = nvapiAdapterRegistry->GetOutput(displayId);
+        if (hPhysicalGpu == nullptr)
+            return InvalidArgument(n);
+
+        auto output = nvapiAdapterRegistry->GetOutputById(displayId);
         if (output == nullptr)
             return InvalidArgument(n);
 
-        *hPhysicalGpu = (NvPhysicalGpuHandle) output->GetParent();
+        *hPhysicalGpu = nvapiAdapterRegistry->GetPhysicalGpuHandle(output->GetParent());
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_SYS_GetDisplayIdFromGpuAndOutputId(NvPhysicalGpuHandle hPhysicalGpu, NvU32 outputId, NvU32* displayId) {
+        constexpr auto n = "NvAPI_SYS_GetDisplayIdFromGpuAndOutputId";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || displayId == nullptr)
+            return InvalidArgument(n);
+
+        auto index = nvapiAdapterRegistry->GetAdapterIndex(hPhysicalGpu);
+        if (index == -1)
+            return ExpectedPhysicalGpuHandle(n);
+
+        auto id = nvapiAdapterRegistry->GetTopology()->GetOutputId(index, outputId);
+        if (id == 0)
+            return InvalidArgument(str::format(n, " ", outputId));
+
+        *displayId = id;
+
+        return Ok(n);
+    }
+
+    NvAPI_Status __cdecl NvAPI_SYS_GetGpuAndOutputIdFromDisplayId(NvU32 displayId, NvPhysicalGpuHandle *hPhysicalGpu, NvU32 *outputId) {
+        constexpr auto n = "NvAPI_SYS_GetGpuAndOutputIdFromDisplayId";
+
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
+        if (nvapiAdapterRegistry == nullptr)
+            return ApiNotInitialized(n);
+
+        if (hPhysicalGpu == nullptr || outputId == nullptr)
+            return InvalidArgument(n);
+
+        auto topology = nvapiAdapterRegistry->GetTopology();
+        auto index = topology->GetOutputIndex(displayId);
+        if (index == -1)
+            return InvalidDisplayId(str::format(n, " ", displayId));
+
+        *hPhysicalGpu = nvapiAdapterRegistry->GetPhysicalGpuHandle(topology->GetOutputParent(index));
+        *outputId = topology->GetOutputMask(index);
 
         return Ok(n);
     }
@@ -24,6 +73,7 @@ extern "C" {
     NvAPI_Status __cdecl NvAPI_SYS_GetDriverAndBranchVersion(NvU32* pDriverVersion, NvAPI_ShortString szBuildBranchString) {
         constexpr auto n = "NvAPI_SYS_GetDriverAndBranchVersion";
 
+        auto nvapiAdapterRegistry = publishedAdapterRegistry.Acquire();
         if (nvapiAdapterRegistry == nullptr)
             return ApiNotInitialized(n);
 
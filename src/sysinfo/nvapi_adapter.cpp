@@ -1,53 +1,202 @@
 #include "nvapi_adapter.h"
-#include "../dxvk/dxvk_interfaces.h"
+#include "nvapi_telemetry_providers.h"
 #include "../util/util_string.h"
+#include "../util/util_env.h"
 #include "../util/util_log.h"
 
+#include <cstdio>
+#include <cctype>
+#include <limits>
+
 namespace dxvk {
+    constexpr auto memoryBudgetInterval = std::chrono::milliseconds(250);
+    constexpr auto telemetryFileEnvName = "DXVK_NVAPI_TELEMETRY_FILE";
+    constexpr auto pciOverrideEnvName = "DXVK_NVAPI_PCI_OVERRIDE";
+    constexpr auto boardOverrideEnvName = "DXVK_NVAPI_BOARD_OVERRIDE";
+
+    // NvAPI reports memory sizes in KB as 32 bit values, saturate instead of wrapping around for huge heaps
+    constexpr uint32_t toKiloBytes(VkDeviceSize size) {
+        return static_cast<uint32_t>(std::min<VkDeviceSize>(size / 1024, std::numeric_limits<uint32_t>::max()));
+    }
+
+    // FP32 cores per SM, the compute chips GP100 and GA100 have half as many as the other chips of their architecture
+    constexpr uint32_t getCoresPerSm(const NvapiArchInfo& archInfo) {
+        switch (archInfo.architecture) {
+            case NV_GPU_ARCHITECTURE_GK100:
+            case NV_GPU_ARCHITECTURE_GK110:
+            case NV_GPU_ARCHITECTURE_GK200:
+                return 192;
+            case NV_GPU_ARCHITECTURE_GM200:
+                return 128;
+            case NV_GPU_ARCHITECTURE_GP100:
+                return archInfo.implementation == NV_GPU_ARCH_IMPLEMENTATION_GP100 ? 64 : 128;
+            case NV_GPU_ARCHITECTURE_GV100:
+            case NV_GPU_ARCHITECTURE_TU100:
+                return 64;
+            case NV_GPU_ARCHITECTURE_GA100:
+                return archInfo.implementation == NV_GPU_ARCH_IMPLEMENTATION_GA100 ? 64 : 128;
+            default:
+                return 0;
+        }
+    }
+
     NvapiAdapter::NvapiAdapter() = default;
 
     NvapiAdapter::~NvapiAdapter() = default;
 
-    bool NvapiAdapter::Initialize(Com<IDXGIAdapter>& dxgiAdapter, std::vector<NvapiOutput*>& outputs) {
-        // Get the Vulkan handle from the DXGI adapter to get access to Vulkan device properties which has some information we want.
-        Com<IDXGIVkInteropAdapter> dxgiVkInteropAdapter;
-        if (FAILED(dxgiAdapter->QueryInterface(IID_PPV_ARGS(&dxgiVkInteropAdapter)))) {
+    bool NvapiAdapter::Initialize(Com<IDXGIAdapter>& dxgiAdapter, const std::shared_ptr<NvapiVulkanDispatch>& vk, const std::shared_ptr<NvapiNvml>& nvml, NvapiAdapterCache& cache) {
+        // Only do the cheap DXGI part here, Vulkan properties are queried on first access since most titles
+        // never look beyond the name and driver version of the first adapter.
+        // Get the Vulkan interop from the DXGI adapter to get access to Vulkan device properties which has some information we want.
+        if (FAILED(dxgiAdapter->QueryInterface(IID_PPV_ARGS(&m_dxgiVkInteropAdapter)))) {
             log::write("Querying Vulkan handle from DXGI adapter failed, please ensure that DXVK's dxgi.dll is loaded");
             return false;
         }
 
-        const auto vkModuleName = "vulkan-1.dll";
-        auto vkModule = ::LoadLibraryA(vkModuleName);
-        if (vkModule == nullptr) {
-            log::write(str::format("Loading ", vkModuleName, " failed with error code ", ::GetLastError()));
+        DXGI_ADAPTER_DESC desc;
+        if (FAILED(dxgiAdapter->GetDesc(&desc)))
             return false;
+
+        // Only returns the handles DXVK already owns, no Vulkan call involved
+        m_dxgiVkInteropAdapter->GetVulkanHandles(&m_vkInstance, &m_vkDevice);
+
+        // Counting the device extensions is cheap and fails for the same devices the full query fails for,
+        // drop those adapters right away instead of reporting zeroed properties later on
+        auto extensionCount = 0U;
+        if (m_vkDevice == VK_NULL_HANDLE || vk->vkEnumerateDeviceExtensionProperties(m_vkDevice, nullptr, &extensionCount, nullptr) != VK_SUCCESS) {
+            log::write("Querying Vulkan device extensions failed");
+            return false;
+        }
+
+        m_dxgiAdapter = dxgiAdapter;
+        m_vk = vk;
+        m_nvml = nvml;
+        m_cache = &cache;
+        m_luid = desc.AdapterLuid;
+        m_dxgiSubSystemId = desc.SubSysId;
+        m_dxgiRevisionId = desc.Revision;
+
+        return true;
+    }
+
+    void NvapiAdapter::InitializeOutputs(const u_short index, std::vector<std::shared_ptr<NvapiOutput>>& outputs) {
+        // Query all outputs from DXVK
+        // Mosaic setup is not supported, thus one display output refers to one GPU
+        Com<IDXGIOutput> dxgiOutput;
+        for (auto i = 0U; m_dxgiAdapter->EnumOutputs(i, &dxgiOutput) != DXGI_ERROR_NOT_FOUND; i++) {
+            auto nvapiOutput = std::make_shared<NvapiOutput>(index);
+            nvapiOutput->Initialize(dxgiOutput);
+            outputs.push_back(nvapiOutput);
+        }
+    }
+
+    bool NvapiAdapter::AreOutputsCurrent(const std::vector<const NvapiOutput*>& outputs) const {
+        // Same outputs in the same order and mode, without reading EDIDs again
+        Com<IDXGIOutput> dxgiOutput;
+        auto i = 0U;
+        for (; m_dxgiAdapter->EnumOutputs(i, &dxgiOutput) != DXGI_ERROR_NOT_FOUND; i++) {
+            if (i >= outputs.size() || !outputs[i]->IsCurrent(dxgiOutput))
+                return false;
         }
 
-        auto vkGetInstanceProcAddr =
-            reinterpret_cast<PFN_vkGetInstanceProcAddr>(
-                reinterpret_cast<void*>(
-                    GetProcAddress(vkModule, "vkGetInstanceProcAddr")));
+        return i == outputs.size();
+    }
 
-        auto vkEnumerateDeviceExtensionProperties =
-            reinterpret_cast<PFN_vkEnumerateDeviceExtensionProperties>(
-                reinterpret_cast<void*>(
-                    GetProcAddress(vkModule, "vkEnumerateDeviceExtensionProperties")));
+    void NvapiAdapter::EnsureVulkanProperties() const {
+        std::call_once(m_vulkanPropertiesInitialized, [this] { initializeVulkanProperties(); });
+    }
 
-        VkInstance vkInstance = VK_NULL_HANDLE;
-        VkPhysicalDevice vkDevice = VK_NULL_HANDLE;
-        dxgiVkInteropAdapter->GetVulkanHandles(&vkInstance, &vkDevice);
+    void NvapiAdapter::initializeVulkanProperties() const {
+        // Cheap query to validate a cached entry against the currently installed driver and Vulkan loader,
+        // the device UUID identifies the adapter across reboots while the LUID does not
+        VkPhysicalDeviceIDProperties deviceIdProperties{};
+        deviceIdProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        deviceIdProperties.pNext = nullptr;
 
-        // Grab last of valid extensions for this device
+        VkPhysicalDeviceProperties2 deviceProperties2;
+        deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties2.pNext = &deviceIdProperties;
+
+        m_vk->vkGetPhysicalDeviceProperties2(m_vkDevice, &deviceProperties2);
+
+        NvapiAdapterCacheKey cacheKey{};
+        std::memcpy(cacheKey.deviceUuid, deviceIdProperties.deviceUUID, sizeof(cacheKey.deviceUuid));
+        cacheKey.vendorId = deviceProperties2.properties.vendorID;
+        cacheKey.deviceId = deviceProperties2.properties.deviceID;
+        cacheKey.driverVersion = deviceProperties2.properties.driverVersion;
+        cacheKey.loaderVersion = m_vk->GetLoaderVersion();
+
+        NvapiAdapterCacheEntry cacheEntry;
+        if (m_cache->Find(cacheKey, cacheEntry)) {
+            m_deviceProperties = cacheEntry.deviceProperties;
+            m_deviceIdProperties = cacheEntry.deviceIdProperties;
+            m_devicePciBusProperties = cacheEntry.devicePciBusProperties;
+            m_memoryProperties = cacheEntry.memoryProperties;
+            m_deviceDriverProperties = cacheEntry.deviceDriverProperties;
+            m_deviceFragmentShadingRateProperties = cacheEntry.deviceFragmentShadingRateProperties;
+            m_deviceSmBuiltinsProperties = cacheEntry.deviceSmBuiltinsProperties;
+            m_deviceExtensions = cacheEntry.deviceExtensions;
+        }
+        else {
+            // The extension count was validated during Initialize, a failure here leaves the
+            // core properties intact and only drops extension dependent ones, which are not cached
+            if (queryVulkanProperties(m_vkDevice)) {
+                cacheEntry.deviceProperties = m_deviceProperties;
+                cacheEntry.deviceIdProperties = m_deviceIdProperties;
+                cacheEntry.devicePciBusProperties = m_devicePciBusProperties;
+                cacheEntry.memoryProperties = m_memoryProperties;
+                cacheEntry.deviceDriverProperties = m_deviceDriverProperties;
+                cacheEntry.deviceFragmentShadingRateProperties = m_deviceFragmentShadingRateProperties;
+                cacheEntry.deviceSmBuiltinsProperties = m_deviceSmBuiltinsProperties;
+                cacheEntry.deviceExtensions = m_deviceExtensions;
+                m_cache->Insert(cacheKey, cacheEntry);
+            }
+            else
+                log::write("Querying Vulkan device extensions failed, extension dependent properties are not available");
+        }
+
+        m_cache->Commit();
+
+        if (m_deviceDriverProperties.driverID == VK_DRIVER_ID_NVIDIA_PROPRIETARY)
+            // Handle NVIDIA version notation
+            m_vkDriverVersion = VK_MAKE_VERSION(
+                VK_VERSION_MAJOR(m_deviceProperties.driverVersion),
+                VK_VERSION_MINOR(m_deviceProperties.driverVersion >> 0) >> 2,
+                VK_VERSION_PATCH(m_deviceProperties.driverVersion >> 2) >> 4);
+        else
+            m_vkDriverVersion = m_deviceProperties.driverVersion;
+
+        initializeMemoryInfo();
+        initializePciInfo();
+        initializeArchInfo();
+        initializeBoardInfo();
+        m_gpuCoreCount = m_deviceSmBuiltinsProperties.shaderSMCount * getCoresPerSm(m_archInfo);
+
+        log::write(str::format("NvAPI Device: ", m_deviceProperties.deviceName, " (",
+            VK_VERSION_MAJOR(m_vkDriverVersion), ".",
+            VK_VERSION_MINOR(m_vkDriverVersion), ".",
+            VK_VERSION_PATCH(m_vkDriverVersion), ")"));
+    }
+
+    bool NvapiAdapter::queryVulkanProperties(VkPhysicalDevice vkDevice) const {
+        // Grab last of valid extensions for this device, without them only the core properties are queried
         auto count = 0U;
-        if (vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &count, nullptr) != VK_SUCCESS)
-            return false;
+        std::vector<VkExtensionProperties> extensions;
+        auto extensionsQueried = m_vk->vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &count, nullptr) == VK_SUCCESS;
+        if (extensionsQueried) {
+            extensions.resize(count);
+            extensionsQueried = m_vk->vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &count, extensions.data()) == VK_SUCCESS;
+        }
 
-        std::vector<VkExtensionProperties> extensions(count);
-        if (vkEnumerateDeviceExtensionProperties(vkDevice, nullptr, &count, extensions.data()) != VK_SUCCESS)
-            return false;
+        if (!extensionsQueried)
+            extensions.clear();
 
-        for (const auto& extension : extensions)
-            m_deviceExtensions.insert(std::string(extension.extensionName));
+        // Only remember the extensions we care about, checking them is a single bit test afterwards
+        for (const auto& extension : extensions) {
+            NvapiVulkanExtension vulkanExtension;
+            if (tryGetVulkanExtension(extension.extensionName, vulkanExtension))
+                m_deviceExtensions.set(static_cast<size_t>(vulkanExtension));
+        }
 
         // Query Properties for this device. Per section 4.1.2. Extending Physical Device From Device Extensions of the Vulkan
         // 1.2.177 Specification, we must first query that a device extension is
@@ -57,78 +206,56 @@ namespace dxvk {
         deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
         deviceProperties2.pNext = nullptr;
 
-        if (isVkDeviceExtensionSupported(VK_EXT_PCI_BUS_INFO_EXTENSION_NAME)) {
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::ExtPciBusInfo)) {
             m_devicePciBusProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PCI_BUS_INFO_PROPERTIES_EXT;
             m_devicePciBusProperties.pNext = deviceProperties2.pNext;
             deviceProperties2.pNext = &m_devicePciBusProperties;
         }
 
-        if (isVkDeviceExtensionSupported(VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME)) {
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::KhrDriverProperties)) {
             m_deviceDriverProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES_KHR;
             m_deviceDriverProperties.pNext = deviceProperties2.pNext;
             deviceProperties2.pNext = &m_deviceDriverProperties;
         }
 
-        if (isVkDeviceExtensionSupported(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)) {
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::KhrFragmentShadingRate)) {
             m_deviceFragmentShadingRateProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_PROPERTIES_KHR;
             m_deviceFragmentShadingRateProperties.pNext = deviceProperties2.pNext;
             deviceProperties2.pNext = &m_deviceFragmentShadingRateProperties;
         }
 
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::NvShaderSmBuiltins)) {
+            m_deviceSmBuiltinsProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_SM_BUILTINS_PROPERTIES_NV;
+            m_deviceSmBuiltinsProperties.pNext = deviceProperties2.pNext;
+            deviceProperties2.pNext = &m_deviceSmBuiltinsProperties;
+        }
+
         m_deviceIdProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
         m_deviceIdProperties.pNext = deviceProperties2.pNext;
         deviceProperties2.pNext = &m_deviceIdProperties;
 
-        auto vkGetPhysicalDeviceProperties2 =
-            reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2>(
-                vkGetInstanceProcAddr(vkInstance, "vkGetPhysicalDeviceProperties2"));
-
-        vkGetPhysicalDeviceProperties2(vkDevice, &deviceProperties2);
+        m_vk->vkGetPhysicalDeviceProperties2(vkDevice, &deviceProperties2);
         m_deviceProperties = deviceProperties2.properties;
 
         VkPhysicalDeviceMemoryProperties2 memoryProperties2;
         memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
         memoryProperties2.pNext = nullptr;
 
-        auto vkGetPhysicalDeviceMemoryProperties2 =
-            reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2>(
-                vkGetInstanceProcAddr(vkInstance, "vkGetPhysicalDeviceMemoryProperties2"));
-
-        vkGetPhysicalDeviceMemoryProperties2(vkDevice, &memoryProperties2);
+        m_vk->vkGetPhysicalDeviceMemoryProperties2(vkDevice, &memoryProperties2);
         m_memoryProperties = memoryProperties2.memoryProperties;
 
-        if (GetDriverId() == VK_DRIVER_ID_NVIDIA_PROPRIETARY)
-            // Handle NVIDIA version notation
-            m_vkDriverVersion = VK_MAKE_VERSION(
-                VK_VERSION_MAJOR(m_deviceProperties.driverVersion),
-                VK_VERSION_MINOR(m_deviceProperties.driverVersion >> 0) >> 2,
-                VK_VERSION_PATCH(m_deviceProperties.driverVersion >> 2) >> 4);
-        else
-            m_vkDriverVersion = m_deviceProperties.driverVersion;
-
-        log::write(str::format("NvAPI Device: ", m_deviceProperties.deviceName, " (",
-            VK_VERSION_MAJOR(m_vkDriverVersion), ".",
-            VK_VERSION_MINOR(m_vkDriverVersion), ".",
-            VK_VERSION_PATCH(m_vkDriverVersion), ")"));
-
-        // Query all outputs from DXVK
-        // Mosaic setup is not supported, thus one display output refers to one GPU
-        Com<IDXGIOutput> dxgiOutput;
-        for (auto i = 0U; dxgiAdapter->EnumOutputs(i, &dxgiOutput) != DXGI_ERROR_NOT_FOUND; i++) {
-            auto nvapiOutput = new NvapiOutput((uintptr_t) this);
-            nvapiOutput->Initialize(dxgiOutput);
-            outputs.push_back(nvapiOutput);
-        }
-
-        FreeLibrary(vkModule);
-        return true;
+        return extensionsQueried;
     }
 
     std::string NvapiAdapter::GetDeviceName() const {
+        EnsureVulkanProperties();
+
         return std::string(m_deviceProperties.deviceName);
     }
 
     uint32_t NvapiAdapter::GetDriverVersion() const {
+        EnsureVulkanProperties();
+
         // Windows releases can only ever have a two digit minor version
         // and does not have a patch number
         return VK_VERSION_MAJOR(m_vkDriverVersion) * 100 +
@@ -136,14 +263,20 @@ namespace dxvk {
     }
 
     VkDriverIdKHR NvapiAdapter::GetDriverId() const {
+        EnsureVulkanProperties();
+
         return m_deviceDriverProperties.driverID;
     }
 
     uint32_t NvapiAdapter::GetDeviceId() const {
+        EnsureVulkanProperties();
+
         return (m_deviceProperties.deviceID << 16) + m_deviceProperties.vendorID;
     }
 
     uint32_t NvapiAdapter::GetGpuType() const {
+        EnsureVulkanProperties();
+
         // The enum values for discrete, integrated and unknown GPU are the same for Vulkan and NvAPI
         auto vkDeviceType = m_deviceProperties.deviceType;
         return vkDeviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU || vkDeviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU
@@ -152,22 +285,86 @@ namespace dxvk {
     }
 
     uint32_t NvapiAdapter::GetBusId() const {
+        EnsureVulkanProperties();
+
         return m_devicePciBusProperties.pciBus;
     }
 
+    const NvapiPciInfo& NvapiAdapter::GetPciInfo() const {
+        EnsureVulkanProperties();
+
+        return m_pciInfo;
+    }
+
     uint32_t NvapiAdapter::GetVRamSize() const {
-        // Not sure if it is completely correct to just look at the first DEVICE_LOCAL heap,
-        // but it seems to give the correct result.
+        EnsureVulkanProperties();
+
+        return toKiloBytes(m_dedicatedMemorySize);
+    }
+
+    uint32_t NvapiAdapter::GetSharedSystemMemorySize() const {
+        EnsureVulkanProperties();
+
+        return toKiloBytes(m_sharedMemorySize);
+    }
+
+    uint32_t NvapiAdapter::GetVirtualFrameBufferSize() const {
+        EnsureVulkanProperties();
+
+        // Everything the GPU can allocate from, dedicated video memory plus shared system memory
+        return toKiloBytes(m_dedicatedMemorySize + m_sharedMemorySize);
+    }
+
+    NvapiMemoryBudget NvapiAdapter::GetMemoryBudget() const {
+        EnsureVulkanProperties();
+
+        if (m_dedicatedHeapMask == 0)
+            return NvapiMemoryBudget{};
+
+        // Without VK_EXT_memory_budget all video memory is assumed to be available
+        if (!isVkDeviceExtensionSupported(NvapiVulkanExtension::ExtMemoryBudget))
+            return NvapiMemoryBudget{m_dedicatedMemorySize, 0};
+
+        std::scoped_lock lock(m_memoryBudgetMutex);
+
+        auto now = std::chrono::steady_clock::now();
+        if (m_memoryBudgetTimestamp != std::chrono::steady_clock::time_point{} && now - m_memoryBudgetTimestamp < memoryBudgetInterval)
+            return m_memoryBudget;
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties{};
+        memoryBudgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        memoryBudgetProperties.pNext = nullptr;
+
+        VkPhysicalDeviceMemoryProperties2 memoryProperties2;
+        memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryProperties2.pNext = &memoryBudgetProperties;
+
+        m_vk->vkGetPhysicalDeviceMemoryProperties2(m_vkDevice, &memoryProperties2);
+
+        m_memoryBudget = NvapiMemoryBudget{};
         for (auto i = 0U; i < m_memoryProperties.memoryHeapCount; i++) {
-            auto heap = m_memoryProperties.memoryHeaps[i];
-            if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
-                return heap.size / 1024;
+            if (!(m_dedicatedHeapMask & (1U << i)))
+                continue;
+
+            m_memoryBudget.budget += memoryBudgetProperties.heapBudget[i];
+            m_memoryBudget.usage += memoryBudgetProperties.heapUsage[i];
         }
+        m_memoryBudgetTimestamp = now;
 
-        return 0;
+        return m_memoryBudget;
+    }
+
+    bool NvapiAdapter::GetTelemetry(NvapiTelemetrySample& sample) const {
+        // Starting the sampler only spawns its thread, nothing is reported until it published its first sample
+        std::call_once(m_telemetryInitialized, [this] { initializeTelemetry(); });
+
+        sample = m_telemetry->GetSample();
+        return sample.fields != 0;
     }
 
     bool NvapiAdapter::GetLUID(LUID* luid) const {
+        EnsureVulkanProperties();
+
         if (!m_deviceIdProperties.deviceLUIDValid)
             return false;
 
@@ -175,35 +372,237 @@ namespace dxvk {
         return true;
     }
 
+    const LUID& NvapiAdapter::GetDxgiLUID() const {
+        return m_luid;
+    }
+
+    const NvapiBoardInfo& NvapiAdapter::GetBoardInfo() const {
+        EnsureVulkanProperties();
+
+        return m_boardInfo;
+    }
+
+    VkInstance NvapiAdapter::GetVkInstance() const {
+        return m_vkInstance;
+    }
+
+    VkPhysicalDevice NvapiAdapter::GetVkPhysicalDevice() const {
+        return m_vkDevice;
+    }
+
     NV_GPU_ARCHITECTURE_ID NvapiAdapter::GetArchitectureId() const {
+        EnsureVulkanProperties();
+
+        return m_archInfo.architecture;
+    }
+
+    const NvapiArchInfo& NvapiAdapter::GetArchInfo() const {
+        EnsureVulkanProperties();
+
+        return m_archInfo;
+    }
+
+    NV_GPU_ARCHITECTURE_ID NvapiAdapter::guessArchitectureId() const {
         // KHR_fragment_shading_rate's
         // primitiveFragmentShadingRateWithMultipleViewports is supported on
         // Ampere and newer
-        if (isVkDeviceExtensionSupported(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::KhrFragmentShadingRate)
             && m_deviceFragmentShadingRateProperties.primitiveFragmentShadingRateWithMultipleViewports)
             return NV_GPU_ARCHITECTURE_GA100;
 
         // Variable rate shading is supported on Turing and newer
-        if (isVkDeviceExtensionSupported(VK_NV_SHADING_RATE_IMAGE_EXTENSION_NAME))
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::NvShadingRateImage))
             return NV_GPU_ARCHITECTURE_TU100;
 
         // VK_NVX_image_view_handle is supported on Volta and newer
-        if (isVkDeviceExtensionSupported(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME))
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::NvxImageViewHandle))
             return NV_GPU_ARCHITECTURE_GV100;
 
         // VK_NV_clip_space_w_scaling is supported on Pascal and newer
-        if (isVkDeviceExtensionSupported(VK_NV_CLIP_SPACE_W_SCALING_EXTENSION_NAME))
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::NvClipSpaceWScaling))
             return NV_GPU_ARCHITECTURE_GP100;
 
         // VK_NV_viewport_array2 is supported on Maxwell and newer
-        if (isVkDeviceExtensionSupported(VK_NV_VIEWPORT_ARRAY2_EXTENSION_NAME))
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::NvViewportArray2))
             return NV_GPU_ARCHITECTURE_GM200;
 
         // Fall back to Kepler
         return NV_GPU_ARCHITECTURE_GK100;
     }
 
-    bool NvapiAdapter::isVkDeviceExtensionSupported(const std::string name) const { // NOLINT(performance-unnecessary-value-param)
-        return m_deviceExtensions.find(name) != m_deviceExtensions.end();
+    uint32_t NvapiAdapter::GetGpuCoreCount() const {
+        EnsureVulkanProperties();
+
+        return m_gpuCoreCount;
+    }
+
+    uint32_t NvapiAdapter::GetShaderSubPipeCount() const {
+        EnsureVulkanProperties();
+
+        // Shader sub pipes are the streaming multiprocessors
+        return m_deviceSmBuiltinsProperties.shaderSMCount;
+    }
+
+    bool NvapiAdapter::isVkDeviceExtensionSupported(const NvapiVulkanExtension extension) const {
+        return m_deviceExtensions.test(static_cast<size_t>(extension));
+    }
+
+    void NvapiAdapter::initializePciInfo() const {
+        // Subsystem and revision are only known to DXGI, DXVK reports both as zero
+        m_pciInfo.subSystemId = m_dxgiSubSystemId;
+        m_pciInfo.revisionId = m_dxgiRevisionId;
+        m_pciInfo.extDeviceId = m_deviceProperties.deviceID;
+
+        // Neither reports the physical slot nor the link width, both stay unknown unless overridden
+        if (isVkDeviceExtensionSupported(NvapiVulkanExtension::ExtPciBusInfo))
+            m_pciInfo.busType = NVAPI_GPU_BUS_TYPE_PCI_EXPRESS;
+
+        env::forEachOverride(pciOverrideEnvName, [this](const std::string& name, const std::string& value) {
+            auto number = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0));
+            if (name == "subsystem")
+                m_pciInfo.subSystemId = number;
+            else if (name == "revision")
+                m_pciInfo.revisionId = number;
+            else if (name == "bustype")
+                m_pciInfo.busType = static_cast<NV_GPU_BUS_TYPE>(number);
+            else if (name == "slot")
+                m_pciInfo.busSlotId = number;
+            else if (name == "width")
+                m_pciInfo.pcieWidth = number;
+            else
+                return false;
+
+            return true;
+        });
+    }
+
+    void NvapiAdapter::initializeBoardInfo() const {
+        std::string deviceName = m_deviceProperties.deviceName;
+
+        // Neither Vulkan nor DXGI know the VBIOS version or the board serial number
+        str::tonvss(m_boardInfo.vbiosVersion, "N/A");
+
+        // Pascal and most Turing notebook parts carry the desktop name, e.g. "GeForce GTX 1060", only their device ID tells
+        auto isMobileDevice = m_deviceProperties.vendorID == 0x10de && isNvidiaMobileDevice(m_deviceProperties.deviceID);
+
+        // Other mobile parts are named e.g. "GeForce GTX 1060 with Max-Q Design", "GeForce GTX 980M" or "GeForce RTX 3060 Laptop GPU"
+        auto isMobileName = deviceName.find("Laptop") != std::string::npos
+            || deviceName.find("Max-Q") != std::string::npos
+            || deviceName.find("Mobile") != std::string::npos
+            || (deviceName.size() > 1 && deviceName.back() == 'M' && std::isdigit(static_cast<unsigned char>(deviceName[deviceName.size() - 2])));
+
+        // A system battery is no hint, desktops report UPS batteries as well, anything else is left to the override
+        m_boardInfo.systemType = isMobileDevice || isMobileName ? NV_SYSTEM_TYPE_LAPTOP : NV_SYSTEM_TYPE_DESKTOP;
+
+        // Workstation parts are named e.g. "Quadro RTX 4000", "NVIDIA RTX A4000" or "NVIDIA RTX 4000 Ada Generation"
+        m_boardInfo.isQuadro = m_deviceProperties.vendorID == 0x10de
+            && (deviceName.find("Quadro") != std::string::npos
+                || deviceName.find("RTX A") != std::string::npos
+                || deviceName.find("Ada Generation") != std::string::npos);
+
+        env::forEachOverride(boardOverrideEnvName, [this](const std::string& name, const std::string& value) {
+            if (name == "vbios")
+                str::tonvss(m_boardInfo.vbiosVersion, value);
+            else if (name == "serial")
+                std::memcpy(m_boardInfo.boardNumber, value.data(), std::min(value.size(), sizeof(m_boardInfo.boardNumber)));
+            else if (name == "systemtype" && (value == "laptop" || value == "desktop"))
+                m_boardInfo.systemType = value == "laptop" ? NV_SYSTEM_TYPE_LAPTOP : NV_SYSTEM_TYPE_DESKTOP;
+            else if (name == "quadro")
+                m_boardInfo.isQuadro = value == "1";
+            else
+                return false;
+
+            return true;
+        });
+    }
+
+    void NvapiAdapter::initializeArchInfo() const {
+        if (m_deviceProperties.vendorID != 0x10de || !tryGetNvidiaArchInfo(m_deviceProperties.deviceID, m_archInfo)) {
+            // Unknown device, assume the implementation ID from the architecture ID
+            m_archInfo.architecture = guessArchitectureId();
+            m_archInfo.revision = NV_GPU_CHIP_REV_A01;
+
+            switch (m_archInfo.architecture) {
+                case NV_GPU_ARCHITECTURE_GM200:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_GM204;
+                    break;
+                case NV_GPU_ARCHITECTURE_GP100:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_GP102;
+                    break;
+                case NV_GPU_ARCHITECTURE_GV100:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_GV100;
+                    break;
+                case NV_GPU_ARCHITECTURE_TU100:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_TU102;
+                    break;
+                case NV_GPU_ARCHITECTURE_GA100:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_GA102;
+                    break;
+                default:
+                    m_archInfo.implementation = NV_GPU_ARCH_IMPLEMENTATION_GK104;
+                    break;
+            }
+        }
+
+        // The PCI revision of NVIDIA chips is the silicon revision, e.g. 0xa1 for A01
+        if ((m_pciInfo.revisionId & 0xf0) == 0xa0 && (m_pciInfo.revisionId & 0x0f) != 0)
+            m_archInfo.revision = static_cast<NV_GPU_CHIP_REVISION>(0x10 | (m_pciInfo.revisionId & 0x0f));
+    }
+
+    void NvapiAdapter::initializeTelemetry() const {
+        // Querying Vulkan properties and loading NVML are slow, both happen on the sampler thread
+        m_telemetry = std::make_unique<NvapiTelemetry>([this]() -> std::unique_ptr<NvapiTelemetryProvider> {
+            EnsureVulkanProperties();
+
+            auto telemetryFile = env::getEnvVariable(telemetryFileEnvName);
+            if (!telemetryFile.empty()) {
+                log::write(str::format(telemetryFileEnvName, " is set, reading GPU telemetry from ", telemetryFile));
+                return std::make_unique<NvapiFileTelemetryProvider>(telemetryFile);
+            }
+
+            // NVML identifies devices by PCI bus ID only
+            if (m_deviceProperties.vendorID != 0x10de
+                || !isVkDeviceExtensionSupported(NvapiVulkanExtension::ExtPciBusInfo)
+                || !m_nvml->IsAvailable())
+                return nullptr;
+
+            char pciBusId[32];
+            std::snprintf(pciBusId, sizeof(pciBusId), "%08x:%02x:%02x.%x",
+                m_devicePciBusProperties.pciDomain,
+                m_devicePciBusProperties.pciBus,
+                m_devicePciBusProperties.pciDevice,
+                m_devicePciBusProperties.pciFunction);
+
+            return std::make_unique<NvapiNvmlTelemetryProvider>(m_nvml, pciBusId);
+        });
+    }
+
+    void NvapiAdapter::initializeMemoryInfo() const {
+        // A device local heap that only backs host visible memory types is the PCI BAR window without resizable BAR,
+        // it is a view into video memory that is already counted and must not be reported twice
+        uint32_t deviceLocalHeapMask = 0;
+        uint32_t deviceOnlyHeapMask = 0;
+        for (auto i = 0U; i < m_memoryProperties.memoryTypeCount; i++) {
+            auto type = m_memoryProperties.memoryTypes[i];
+            if (!(m_memoryProperties.memoryHeaps[type.heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+                continue;
+
+            deviceLocalHeapMask |= 1U << type.heapIndex;
+            if (!(type.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+                deviceOnlyHeapMask |= 1U << type.heapIndex;
+        }
+
+        // Integrated GPUs expose all of their memory as host visible, there is no BAR window to exclude
+        m_dedicatedHeapMask = deviceOnlyHeapMask != 0 ? deviceOnlyHeapMask : deviceLocalHeapMask;
+
+        m_dedicatedMemorySize = 0;
+        m_sharedMemorySize = 0;
+        for (auto i = 0U; i < m_memoryProperties.memoryHeapCount; i++) {
+            auto heap = m_memoryProperties.memoryHeaps[i];
+            if (m_dedicatedHeapMask & (1U << i))
+                m_dedicatedMemorySize += heap.size;
+            else if (!(heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+                m_sharedMemorySize += heap.size;
+        }
     }
 }
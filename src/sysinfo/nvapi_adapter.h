@@ -2,38 +2,121 @@
 
 #include "../nvapi_private.h"
 #include "../util/com_pointer.h"
+#include "../dxvk/dxvk_interfaces.h"
+#include "nvapi_adapter_cache.h"
+#include "nvapi_vulkan_dispatch.h"
+#include "nvapi_vulkan_extensions.h"
 #include "nvapi_output.h"
+#include "nvapi_device_table.h"
+#include "nvapi_nvml.h"
+#include "nvapi_telemetry.h"
 
-#include <set>
+#include <mutex>
+#include <chrono>
 
 namespace dxvk {
+    struct NvapiMemoryBudget {
+        uint64_t budget;
+        uint64_t usage;
+    };
+
+    struct NvapiPciInfo {
+        uint32_t subSystemId;
+        uint32_t revisionId;
+        uint32_t extDeviceId;
+        NV_GPU_BUS_TYPE busType;
+        uint32_t busSlotId; // 0 if unknown
+        uint32_t pcieWidth; // 0 if unknown
+    };
+
+    struct NvapiBoardInfo {
+        NvAPI_ShortString vbiosVersion;
+        uint8_t boardNumber[16];
+        NV_SYSTEM_TYPE systemType;
+        bool isQuadro;
+    };
+
     class NvapiAdapter {
 
     public:
         NvapiAdapter();
         ~NvapiAdapter();
 
-        bool Initialize(Com<IDXGIAdapter>& dxgiAdapter, std::vector<NvapiOutput*>& outputs);
+        bool Initialize(Com<IDXGIAdapter>& dxgiAdapter, const std::shared_ptr<NvapiVulkanDispatch>& vk, const std::shared_ptr<NvapiNvml>& nvml, NvapiAdapterCache& cache);
+        void InitializeOutputs(u_short index, std::vector<std::shared_ptr<NvapiOutput>>& outputs);
+        [[nodiscard]] bool AreOutputsCurrent(const std::vector<const NvapiOutput*>& outputs) const;
+        void EnsureVulkanProperties() const;
         [[nodiscard]] std::string GetDeviceName() const;
         [[nodiscard]] VkDriverIdKHR GetDriverId() const;
         [[nodiscard]] uint32_t GetDriverVersion() const;
         [[nodiscard]] uint32_t GetDeviceId() const;
         [[nodiscard]] uint32_t GetGpuType() const;
         [[nodiscard]] uint32_t GetBusId() const;
+        [[nodiscard]] const NvapiPciInfo& GetPciInfo() const;
         [[nodiscard]] uint32_t GetVRamSize() const;
+        [[nodiscard]] uint32_t GetSharedSystemMemorySize() const;
+        [[nodiscard]] uint32_t GetVirtualFrameBufferSize() const;
+        [[nodiscard]] NvapiMemoryBudget GetMemoryBudget() const;
+        [[nodiscard]] bool GetTelemetry(NvapiTelemetrySample& sample) const;
         [[nodiscard]] bool GetLUID(LUID *luid) const;
+        // DXVK makes one up when Vulkan has no LUID, only meant for matching DXGI objects of this process
+        [[nodiscard]] const LUID& GetDxgiLUID() const;
+        [[nodiscard]] VkInstance GetVkInstance() const;
+        [[nodiscard]] VkPhysicalDevice GetVkPhysicalDevice() const;
         [[nodiscard]] NV_GPU_ARCHITECTURE_ID GetArchitectureId() const;
+        [[nodiscard]] const NvapiArchInfo& GetArchInfo() const;
+        [[nodiscard]] const NvapiBoardInfo& GetBoardInfo() const;
+        [[nodiscard]] uint32_t GetGpuCoreCount() const;
+        [[nodiscard]] uint32_t GetShaderSubPipeCount() const;
 
     private:
-        [[nodiscard]] bool isVkDeviceExtensionSupported(std::string name) const;
-
-        VkPhysicalDeviceProperties m_deviceProperties{};
-        VkPhysicalDeviceIDProperties m_deviceIdProperties{};
-        VkPhysicalDevicePCIBusInfoPropertiesEXT m_devicePciBusProperties{};
-        VkPhysicalDeviceMemoryProperties m_memoryProperties{};
-        VkPhysicalDeviceDriverPropertiesKHR m_deviceDriverProperties{};
-        VkPhysicalDeviceFragmentShadingRatePropertiesKHR m_deviceFragmentShadingRateProperties{};
-        uint32_t m_vkDriverVersion{};
-        std::set<std::string> m_deviceExtensions{};
+        void initializeVulkanProperties() const;
+        bool queryVulkanProperties(VkPhysicalDevice vkDevice) const;
+        [[nodiscard]] bool isVkDeviceExtensionSupported(NvapiVulkanExtension extension) const;
+        void initializeMemoryInfo() const;
+        [[nodiscard]] NV_GPU_ARCHITECTURE_ID guessArchitectureId() const;
+        void initializePciInfo() const;
+        void initializeArchInfo() const;
+        void initializeBoardInfo() const;
+        void initializeTelemetry() const;
+
+        Com<IDXGIAdapter> m_dxgiAdapter;
+        Com<IDXGIVkInteropAdapter> m_dxgiVkInteropAdapter;
+        std::shared_ptr<NvapiVulkanDispatch> m_vk;
+        std::shared_ptr<NvapiNvml> m_nvml;
+        NvapiAdapterCache* m_cache{};
+        LUID m_luid{};
+        uint32_t m_dxgiSubSystemId{};
+        uint32_t m_dxgiRevisionId{};
+        VkInstance m_vkInstance{};
+        VkPhysicalDevice m_vkDevice{};
+
+        // Everything below is queried from Vulkan on first access, which is logically part of every const getter
+        mutable std::once_flag m_vulkanPropertiesInitialized;
+        mutable VkPhysicalDeviceProperties m_deviceProperties{};
+        mutable VkPhysicalDeviceIDProperties m_deviceIdProperties{};
+        mutable VkPhysicalDevicePCIBusInfoPropertiesEXT m_devicePciBusProperties{};
+        mutable VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+        mutable VkPhysicalDeviceDriverPropertiesKHR m_deviceDriverProperties{};
+        mutable VkPhysicalDeviceFragmentShadingRatePropertiesKHR m_deviceFragmentShadingRateProperties{};
+        mutable VkPhysicalDeviceShaderSMBuiltinsPropertiesNV m_deviceSmBuiltinsProperties{};
+        mutable uint32_t m_vkDriverVersion{};
+        mutable NvapiVulkanExtensionSet m_deviceExtensions{};
+        mutable uint32_t m_gpuCoreCount{};
+        mutable uint32_t m_dedicatedHeapMask{};
+        mutable VkDeviceSize m_dedicatedMemorySize{};
+        mutable VkDeviceSize m_sharedMemorySize{};
+        mutable NvapiPciInfo m_pciInfo{};
+        mutable NvapiArchInfo m_archInfo{};
+        mutable NvapiBoardInfo m_boardInfo{};
+
+        // Titles poll the budget per frame, only query Vulkan again after the sample expired
+        mutable std::mutex m_memoryBudgetMutex;
+        mutable std::chrono::steady_clock::time_point m_memoryBudgetTimestamp{};
+        mutable NvapiMemoryBudget m_memoryBudget{};
+
+        // Telemetry is sampled in the background once a title asked for it, declared last to stop sampling first
+        mutable std::once_flag m_telemetryInitialized;
+        mutable std::unique_ptr<NvapiTelemetry> m_telemetry;
     };
 }
@@ -0,0 +1,247 @@
+#include "nvapi_adapter_cache.h"
+#include "../util/util_string.h"
+#include "../util/util_env.h"
+#include "../util/util_log.h"
+
+namespace dxvk {
+    constexpr auto cachePathEnvName = "DXVK_NVAPI_CACHE_PATH";
+    constexpr auto cacheFileName = "dxvk-nvapi.cache";
+    constexpr char cacheMagic[8] = { 'D', 'X', 'N', 'V', 'A', 'P', 'I', 'C' };
+    constexpr uint32_t cacheFormatVersion = 4;
+
+    static_assert(static_cast<size_t>(NvapiVulkanExtension::Count) <= 64, "Extension set is persisted as a 64 bit mask");
+
+    // Guards against reading a cache written by a build with different Vulkan headers or bitness
+    constexpr uint32_t cachePodSize = sizeof(NvapiAdapterCacheKey)
+        + sizeof(VkPhysicalDeviceProperties)
+        + sizeof(VkPhysicalDeviceIDProperties)
+        + sizeof(VkPhysicalDevicePCIBusInfoPropertiesEXT)
+        + sizeof(VkPhysicalDeviceMemoryProperties)
+        + sizeof(VkPhysicalDeviceDriverPropertiesKHR)
+        + sizeof(VkPhysicalDeviceFragmentShadingRatePropertiesKHR)
+        + sizeof(VkPhysicalDeviceShaderSMBuiltinsPropertiesNV);
+
+    template<typename T>
+    bool read(std::istream& stream, T& value) {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    template<typename T>
+    void write(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Vulkan property structs are stored as plain data, never persist or restore the pNext chain
+    template<typename T>
+    bool readProperties(std::istream& stream, T& value) {
+        if (!read(stream, value))
+            return false;
+
+        value.pNext = nullptr;
+        return true;
+    }
+
+    template<typename T>
+    void writeProperties(std::ostream& stream, T value) {
+        value.pNext = nullptr;
+        write(stream, value);
+    }
+
+    uint64_t getDxvkStamp() {
+        // DXVK does not expose its version, use size and modification time of the loaded dxgi.dll instead
+        auto module = ::GetModuleHandleW(L"dxgi.dll");
+        if (module == nullptr)
+            return 0;
+
+        std::vector<WCHAR> path;
+        path.resize(MAX_PATH + 1);
+        auto length = ::GetModuleFileNameW(module, path.data(), MAX_PATH);
+        path.resize(length);
+        path.push_back(L'\0');
+
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!::GetFileAttributesExW(path.data(), GetFileExInfoStandard, &attributes))
+            return 0;
+
+        // FNV-1a over the relevant attributes
+        const DWORD values[] = {
+            attributes.ftLastWriteTime.dwLowDateTime,
+            attributes.ftLastWriteTime.dwHighDateTime,
+            attributes.nFileSizeLow,
+            attributes.nFileSizeHigh };
+
+        auto hash = 0xcbf29ce484222325ULL;
+        for (auto value : values) {
+            for (auto i = 0U; i < sizeof(value); i++) {
+                hash ^= (value >> (i * 8)) & 0xff;
+                hash *= 0x100000001b3ULL;
+            }
+        }
+
+        return hash;
+    }
+
+    bool isSameDevice(const NvapiAdapterCacheKey& a, const NvapiAdapterCacheKey& b) {
+        return memcmp(a.deviceUuid, b.deviceUuid, sizeof(a.deviceUuid)) == 0;
+    }
+
+    bool isSameKey(const NvapiAdapterCacheKey& a, const NvapiAdapterCacheKey& b) {
+        return isSameDevice(a, b)
+            && a.vendorId == b.vendorId
+            && a.deviceId == b.deviceId
+            && a.driverVersion == b.driverVersion
+            && a.loaderVersion == b.loaderVersion;
+    }
+
+    NvapiAdapterCache::NvapiAdapterCache() = default;
+
+    NvapiAdapterCache::~NvapiAdapterCache() = default;
+
+    void NvapiAdapterCache::Load() {
+        std::scoped_lock lock(m_mutex);
+
+        auto cachePath = env::getEnvVariable(cachePathEnvName);
+        if (cachePath.empty())
+            return;
+
+        if ((*cachePath.rbegin()) != '/')
+            cachePath += '/';
+
+        m_path = cachePath + cacheFileName;
+        m_dxvkStamp = getDxvkStamp();
+
+        std::ifstream stream(m_path, std::ios::binary);
+        if (!stream)
+            return;
+
+        char magic[sizeof(cacheMagic)];
+        uint32_t version, podSize, count;
+        uint64_t extensionTableHash, dxvkStamp;
+        if (!read(stream, magic) || !read(stream, version) || !read(stream, podSize) || !read(stream, extensionTableHash) || !read(stream, dxvkStamp) || !read(stream, count)
+            || memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 || version != cacheFormatVersion || podSize != cachePodSize
+            || extensionTableHash != vulkanExtensionTableHash() || dxvkStamp != m_dxvkStamp || count > NVAPI_MAX_PHYSICAL_GPUS) {
+            log::write(str::format("Ignoring outdated or invalid adapter cache ", m_path));
+            return;
+        }
+
+        std::vector<Record> records(count);
+        for (auto& [key, entry, isCurrent] : records) {
+            uint64_t extensions;
+            if (!read(stream, key)
+                || !read(stream, entry.deviceProperties)
+                || !readProperties(stream, entry.deviceIdProperties)
+                || !readProperties(stream, entry.devicePciBusProperties)
+                || !read(stream, entry.memoryProperties)
+                || !readProperties(stream, entry.deviceDriverProperties)
+                || !readProperties(stream, entry.deviceFragmentShadingRateProperties)
+                || !readProperties(stream, entry.deviceSmBuiltinsProperties)
+                || !read(stream, extensions))
+                return;
+
+            entry.deviceExtensions = NvapiVulkanExtensionSet(extensions);
+        }
+
+        m_records = std::move(records);
+        log::write(str::format("Loaded ", m_records.size(), " adapter(s) from cache ", m_path));
+    }
+
+    void NvapiAdapterCache::Expect(const size_t adapterCount) {
+        std::scoped_lock lock(m_mutex);
+
+        m_pendingCount = adapterCount;
+    }
+
+    void NvapiAdapterCache::Commit() {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_pendingCount == 0 || --m_pendingCount != 0)
+            return;
+
+        store();
+    }
+
+    void NvapiAdapterCache::store() {
+        if (m_path.empty() || !m_dirty)
+            return;
+
+        // Entries of adapters that are gone are not worth keeping, this also keeps the file within the adapter limit
+        std::vector<const Record*> records;
+        for (const auto& record : m_records) {
+            if (record.isCurrent)
+                records.push_back(&record);
+        }
+
+        // Write to a process specific file first and swap it in afterwards, other processes may read the cache concurrently
+        auto tempPath = str::format(m_path, ".", ::GetCurrentProcessId());
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                log::write(str::format("Writing adapter cache ", tempPath, " failed"));
+                return;
+            }
+
+            write(stream, cacheMagic);
+            write(stream, cacheFormatVersion);
+            write(stream, cachePodSize);
+            write(stream, vulkanExtensionTableHash());
+            write(stream, m_dxvkStamp);
+            write(stream, static_cast<uint32_t>(records.size()));
+
+            for (const auto record : records) {
+                const auto& [key, entry, isCurrent] = *record;
+                write(stream, key);
+                write(stream, entry.deviceProperties);
+                writeProperties(stream, entry.deviceIdProperties);
+                writeProperties(stream, entry.devicePciBusProperties);
+                write(stream, entry.memoryProperties);
+                writeProperties(stream, entry.deviceDriverProperties);
+                writeProperties(stream, entry.deviceFragmentShadingRateProperties);
+                writeProperties(stream, entry.deviceSmBuiltinsProperties);
+                write(stream, static_cast<uint64_t>(entry.deviceExtensions.to_ullong()));
+            }
+        }
+
+        if (!::MoveFileExW(str::tows(tempPath.c_str()).c_str(), str::tows(m_path.c_str()).c_str(), MOVEFILE_REPLACE_EXISTING)) {
+            log::write(str::format("Replacing adapter cache ", m_path, " failed with error code ", ::GetLastError()));
+            return;
+        }
+
+        m_dirty = false;
+    }
+
+    bool NvapiAdapterCache::Find(const NvapiAdapterCacheKey& key, NvapiAdapterCacheEntry& entry) {
+        std::scoped_lock lock(m_mutex);
+
+        auto it = std::find_if(m_records.begin(), m_records.end(),
+            [&key](const auto& record) {
+                return isSameKey(record.key, key);
+            });
+
+        if (it == m_records.end())
+            return false;
+
+        it->isCurrent = true;
+        entry = it->entry;
+        return true;
+    }
+
+    void NvapiAdapterCache::Insert(const NvapiAdapterCacheKey& key, const NvapiAdapterCacheEntry& entry) {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_path.empty())
+            return;
+
+        // Replace any outdated entry for the same device, e.g. after a driver update
+        auto it = std::find_if(m_records.begin(), m_records.end(),
+            [&key](const auto& record) {
+                return isSameDevice(record.key, key);
+            });
+
+        if (it != m_records.end())
+            *it = Record{key, entry, true};
+        else
+            m_records.push_back(Record{key, entry, true});
+
+        m_dirty = true;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../nvapi_private.h"
+#include "nvapi_vulkan_extensions.h"
+
+#include <mutex>
+
+namespace dxvk {
+    struct NvapiAdapterCacheKey {
+        uint8_t deviceUuid[VK_UUID_SIZE]; // Stable across reboots, unlike the LUID
+        uint32_t vendorId;
+        uint32_t deviceId;
+        uint32_t driverVersion;
+        uint32_t loaderVersion;
+    };
+
+    struct NvapiAdapterCacheEntry {
+        VkPhysicalDeviceProperties deviceProperties{};
+        VkPhysicalDeviceIDProperties deviceIdProperties{};
+        VkPhysicalDevicePCIBusInfoPropertiesEXT devicePciBusProperties{};
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        VkPhysicalDeviceDriverPropertiesKHR deviceDriverProperties{};
+        VkPhysicalDeviceFragmentShadingRatePropertiesKHR deviceFragmentShadingRateProperties{};
+        VkPhysicalDeviceShaderSMBuiltinsPropertiesNV deviceSmBuiltinsProperties{};
+        NvapiVulkanExtensionSet deviceExtensions{};
+    };
+
+    class NvapiAdapterCache {
+
+    public:
+        NvapiAdapterCache();
+        ~NvapiAdapterCache();
+
+        void Load();
+
+        // Adapters resolve their entries lazily, possibly in parallel, the file is
+        // written once after the last of the expected adapters committed
+        void Expect(size_t adapterCount);
+        void Commit();
+
+        [[nodiscard]] bool Find(const NvapiAdapterCacheKey& key, NvapiAdapterCacheEntry& entry);
+        void Insert(const NvapiAdapterCacheKey& key, const NvapiAdapterCacheEntry& entry);
+
+    private:
+        struct Record {
+            NvapiAdapterCacheKey key;
+            NvapiAdapterCacheEntry entry;
+            bool isCurrent; // Belongs to an adapter of this process, anything else is dropped on store
+        };
+
+        void store();
+
+        std::mutex m_mutex;
+        std::string m_path;
+        uint64_t m_dxvkStamp{};
+        std::vector<Record> m_records;
+        size_t m_pendingCount{};
+        bool m_dirty{};
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../util/util_work_pool.h"
+
+#include <vector>
+
+namespace dxvk {
+    // Probing mostly waits for the loader and the driver, a few threads pay off even on a single CPU
+    constexpr auto maxProbeThreads = 4U;
+
+    /**
+     * \brief Probes adapters and their outputs on a work pool
+     *
+     * Queries the Vulkan properties and the outputs of every adapter,
+     * outputs are stored per adapter index. Used by the registry and,
+     * with mocked adapters, by the probing benchmark.
+     */
+    template<typename Adapter, typename Output>
+    void startProbing(WorkPool& pool, const std::vector<Adapter*>& adapters, std::vector<std::vector<Output>>& probedOutputs) {
+        probedOutputs.resize(adapters.size());
+        pool.Start(adapters.size(), maxProbeThreads, [&adapters, &probedOutputs](const size_t i) {
+            adapters[i]->EnsureVulkanProperties();
+            adapters[i]->InitializeOutputs(i, probedOutputs[i]);
+        });
+    }
+}
@@ -1,17 +1,28 @@
 #include "nvapi_adapter_registry.h"
+#include "../util/util_string.h"
+#include "../util/util_log.h"
+
+#include <chrono>
 
 namespace dxvk {
 
-    NvapiAdapterRegistry::NvapiAdapterRegistry() = default;
+    // Every registry hands out handles of its own generation, handles from a previous NvAPI_Initialize are rejected
+    static std::atomic<uint32_t> nextGeneration{};
+
+    constexpr auto refreshInterval = std::chrono::seconds(1);
+
+    NvapiAdapterRegistry::NvapiAdapterRegistry() : m_generation(nextGeneration++) {}
 
     NvapiAdapterRegistry::~NvapiAdapterRegistry() {
-        for (const auto output : m_nvapiOutputs)
-            delete output;
+        m_probePool.Join();
+
+        // Unpublished and synchronized by the owner, no reader is left, neither of the current nor of a retired snapshot
+        delete m_topology.Exchange(nullptr);
+        m_retiredTopologies.clear();
 
         for (const auto adapter : m_nvapiAdapters)
             delete adapter;
 
-        m_nvapiOutputs.clear();
         m_nvapiAdapters.clear();
     }
 
@@ -20,17 +31,97 @@ namespace dxvk {
         if(FAILED(::CreateDXGIFactory(__uuidof(IDXGIFactory), (void**)&dxgiFactory)))
             return false;
 
+        // Load the Vulkan loader once for all adapters
+        m_vk = std::make_shared<NvapiVulkanDispatch>();
+        if (!m_vk->Load())
+            return false;
+
+        // NVML is only loaded once telemetry is requested
+        m_nvml = std::make_shared<NvapiNvml>();
+
+        m_cache.Load();
+
         // Query all D3D11 adapter from DXVK to honor any DXVK device filtering
         Com<IDXGIAdapter> dxgiAdapter;
         for (auto i = 0U; dxgiFactory->EnumAdapters(i, &dxgiAdapter) != DXGI_ERROR_NOT_FOUND; i++) {
             auto nvapiAdapter = new NvapiAdapter();
-            if (nvapiAdapter->Initialize(dxgiAdapter, m_nvapiOutputs))
+            if (nvapiAdapter->Initialize(dxgiAdapter, m_vk, m_nvml, m_cache))
                 m_nvapiAdapters.push_back(nvapiAdapter);
             else
                 delete nvapiAdapter;
         }
 
-        return !m_nvapiAdapters.empty();
+        if (m_nvapiAdapters.empty())
+            return false;
+
+        m_cache.Expect(m_nvapiAdapters.size());
+
+        initializeLogicalGpus();
+        startProbing();
+        return true;
+    }
+
+    void NvapiAdapterRegistry::initializeLogicalGpus() {
+        // All adapters come from DXVK's single Vulkan instance, enumerating its device groups is cheap
+        std::vector<VkPhysicalDeviceGroupProperties> groups;
+        auto vkInstance = m_nvapiAdapters.front()->GetVkInstance();
+        auto count = 0U;
+        if (vkInstance != VK_NULL_HANDLE && m_vk->vkEnumeratePhysicalDeviceGroups(vkInstance, &count, nullptr) == VK_SUCCESS) {
+            VkPhysicalDeviceGroupProperties group{};
+            group.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES;
+            groups.resize(count, group);
+            if (m_vk->vkEnumeratePhysicalDeviceGroups(vkInstance, &count, groups.data()) != VK_SUCCESS)
+                groups.clear();
+        }
+
+        auto findGroup = [&groups](VkPhysicalDevice vkDevice) {
+            for (auto i = 0U; i < groups.size(); i++)
+                for (auto j = 0U; j < groups[i].physicalDeviceCount; j++)
+                    if (groups[i].physicalDevices[j] == vkDevice)
+                        return static_cast<int32_t>(i);
+
+            return -1;
+        };
+
+        std::vector<int32_t> adapterGroups(m_nvapiAdapters.size());
+        std::vector<LUID> adapterLuids(m_nvapiAdapters.size());
+        for (auto i = 0U; i < m_nvapiAdapters.size(); i++) {
+            adapterGroups[i] = findGroup(m_nvapiAdapters[i]->GetVkPhysicalDevice());
+            adapterLuids[i] = m_nvapiAdapters[i]->GetDxgiLUID();
+        }
+
+        // Every adapter joins the logical GPU of the first adapter it shares a LUID or device group with
+        m_logicalGpuIndices.resize(m_nvapiAdapters.size());
+        for (auto i = 0U; i < m_nvapiAdapters.size(); i++) {
+            auto j = 0U;
+            for (; j < i; j++) {
+                auto sameLuid = adapterLuids[i].LowPart == adapterLuids[j].LowPart && adapterLuids[i].HighPart == adapterLuids[j].HighPart;
+                auto sameGroup = adapterGroups[i] != -1 && adapterGroups[i] == adapterGroups[j];
+                if (sameLuid || sameGroup)
+                    break;
+            }
+
+            if (j == i) {
+                m_logicalGpuIndices[i] = m_logicalGpuAdapters.size();
+                m_logicalGpuAdapters.emplace_back();
+            }
+            else
+                m_logicalGpuIndices[i] = m_logicalGpuIndices[j];
+
+            m_logicalGpuAdapters[m_logicalGpuIndices[i]].push_back(i);
+        }
+
+        if (m_logicalGpuAdapters.size() != m_nvapiAdapters.size())
+            log::write(str::format("NvAPI Logical GPUs: ", m_logicalGpuAdapters.size(), " for ", m_nvapiAdapters.size(), " physical GPUs"));
+    }
+
+    void NvapiAdapterRegistry::startProbing() {
+        // Single adapter systems stay completely lazy
+        if (m_nvapiAdapters.size() < 2)
+            return;
+
+        // Results are stored per adapter index to keep a deterministic order
+        dxvk::startProbing(m_probePool, m_nvapiAdapters, m_probedOutputs);
     }
 
     u_short NvapiAdapterRegistry::GetAdapterCount() const {
@@ -45,33 +136,153 @@ namespace dxvk {
         return index < m_nvapiAdapters.size() ? m_nvapiAdapters[index] : nullptr;
     }
 
-    bool NvapiAdapterRegistry::IsAdapter(NvapiAdapter* handle) const {
-        return std::find(m_nvapiAdapters.begin(), m_nvapiAdapters.end(), handle) != m_nvapiAdapters.end();
+    NvapiAdapter* NvapiAdapterRegistry::GetAdapter(NvPhysicalGpuHandle handle) const {
+        auto index = GetAdapterIndex(handle);
+        return index != -1 ? m_nvapiAdapters[index] : nullptr;
+    }
+
+    short NvapiAdapterRegistry::GetAdapterIndex(NvPhysicalGpuHandle handle) const {
+        uint32_t index;
+        return handle::decode(handle, m_generation, index) && index < m_nvapiAdapters.size() ? static_cast<short>(index) : -1;
+    }
+
+    NvPhysicalGpuHandle NvapiAdapterRegistry::GetPhysicalGpuHandle(const u_short index) const {
+        return handle::encode<NvPhysicalGpuHandle>(m_generation, index);
+    }
+
+    u_short NvapiAdapterRegistry::GetLogicalGpuCount() const {
+        return m_logicalGpuAdapters.size();
+    }
+
+    short NvapiAdapterRegistry::GetLogicalGpuIndex(NvLogicalGpuHandle handle) const {
+        uint32_t index;
+        return handle::decode(handle, m_generation, index) && index < m_logicalGpuAdapters.size() ? static_cast<short>(index) : -1;
+    }
+
+    u_short NvapiAdapterRegistry::GetLogicalGpuIndex(const u_short adapterIndex) const {
+        return m_logicalGpuIndices[adapterIndex];
+    }
+
+    const std::vector<u_short>& NvapiAdapterRegistry::GetLogicalGpuAdapters(const u_short index) const {
+        return m_logicalGpuAdapters[index];
+    }
+
+    NvLogicalGpuHandle NvapiAdapterRegistry::GetLogicalGpuHandle(const u_short index) const {
+        return handle::encode<NvLogicalGpuHandle>(m_generation, index);
     }
 
     NvapiOutput* NvapiAdapterRegistry::GetOutput(const u_short index) const {
-        return index < m_nvapiOutputs.size() ? m_nvapiOutputs[index] : nullptr;
+        return GetTopology()->GetOutput(index);
+    }
+
+    NvapiOutput* NvapiAdapterRegistry::GetOutput(NvDisplayHandle handle) const {
+        // Display handles carry the lower half of the display ID
+        uint32_t index;
+        return handle::decode(handle, m_generation, index) ? GetTopology()->GetOutputById(NvapiTopology::displayIdBase | index) : nullptr;
+    }
+
+    NvapiOutput* NvapiAdapterRegistry::GetOutputById(const uint32_t id) const {
+        return GetTopology()->GetOutputById(id);
+    }
+
+    NvDisplayHandle NvapiAdapterRegistry::GetDisplayHandle(const u_short index) const {
+        auto topology = GetTopology();
+        return index < topology->GetOutputCount() ? handle::encode<NvDisplayHandle>(m_generation, topology->GetOutputId(index) & 0xffff) : nullptr;
+    }
+
+    uint32_t NvapiAdapterRegistry::GetPrimaryOutputId() const {
+        return GetTopology()->GetPrimaryOutputId();
+    }
+
+    uint32_t NvapiAdapterRegistry::GetOutputId(const std::string_view displayName) const {
+        return GetTopology()->GetOutputId(displayName);
+    }
+
+    const NvapiTopology* NvapiAdapterRegistry::GetTopology() const {
+        if (auto topology = m_topology.Load(); topology != nullptr) {
+            if (!isRefreshDue())
+                return topology;
+
+            refresh();
+            return m_topology.Load();
+        }
+
+        std::scoped_lock lock(m_topologyMutex);
+        if (auto topology = m_topology.Load(); topology != nullptr)
+            return topology;
+
+        std::vector<std::shared_ptr<NvapiOutput>> outputs;
+        if (m_probedOutputs.empty()) {
+            outputs = enumerateOutputs();
+        } else {
+            m_probePool.Join();
+
+            for (const auto& probed : m_probedOutputs)
+                outputs.insert(outputs.end(), probed.begin(), probed.end());
+
+            m_probedOutputs.clear();
+        }
+
+        // Nothing was published before, there is no previous snapshot to reclaim
+        auto topology = new NvapiTopology();
+        topology->Initialize(std::move(outputs), nullptr);
+        m_topology.Exchange(topology);
+
+        m_nextRefresh = (std::chrono::steady_clock::now() + refreshInterval).time_since_epoch().count();
+
+        return topology;
     }
 
-    bool NvapiAdapterRegistry::IsOutput(NvapiOutput* handle) const {
-        return std::find(m_nvapiOutputs.begin(), m_nvapiOutputs.end(), handle) != m_nvapiOutputs.end();
+    bool NvapiAdapterRegistry::isRefreshDue() const {
+        // Readers only compare a timestamp, the first one after the interval refreshes on its own thread
+        auto now = std::chrono::steady_clock::now();
+        auto next = m_nextRefresh.load(std::memory_order_relaxed);
+        return now.time_since_epoch().count() >= next
+            && m_nextRefresh.compare_exchange_strong(next, (now + refreshInterval).time_since_epoch().count(), std::memory_order_relaxed);
     }
 
-    short NvapiAdapterRegistry::GetPrimaryOutputId() const {
-        auto it = std::find_if(m_nvapiOutputs.begin(), m_nvapiOutputs.end(),
-            [](const auto& output) {
-                return output->IsPrimary();
-            });
+    void NvapiAdapterRegistry::refresh() const {
+        // Only DXGI outputs are enumerated again, adapters and their Vulkan properties are left alone
+        std::scoped_lock lock(m_topologyMutex);
+
+        // The calling reader holds a guard, the current snapshot cannot go away underneath
+        auto current = m_topology.Load();
+        if (isTopologyCurrent(*current))
+            return;
+
+        auto topology = new NvapiTopology();
+        topology->Initialize(enumerateOutputs(), current);
+        if (topology->IsEquivalent(*current)) {
+            delete topology;
+            return;
+        }
+
+        log::write("NvAPI Output topology changed");
+
+        // Other readers may still use the previous snapshot and this reader cannot wait for a grace period
+        // while holding a guard itself, retired snapshots are freed along with the registry on unload
+        m_topology.Exchange(topology);
+        m_retiredTopologies.emplace_back(current);
+    }
+
+    bool NvapiAdapterRegistry::isTopologyCurrent(const NvapiTopology& topology) const {
+        std::vector<std::vector<const NvapiOutput*>> outputs(m_nvapiAdapters.size());
+        for (auto i = 0U; i < topology.GetOutputCount(); i++)
+            outputs[topology.GetOutputParent(i)].push_back(topology.GetOutput(i));
+
+        for (auto i = 0U; i < m_nvapiAdapters.size(); i++) {
+            if (!m_nvapiAdapters[i]->AreOutputsCurrent(outputs[i]))
+                return false;
+        }
 
-        return static_cast<short>(it != m_nvapiOutputs.end() ? std::distance(m_nvapiOutputs.begin(), it) : -1);
+        return true;
     }
 
-    short NvapiAdapterRegistry::GetOutputId(const std::string& displayName) const {
-        auto it = std::find_if(m_nvapiOutputs.begin(), m_nvapiOutputs.end(),
-            [&displayName](const auto& output) {
-                return output->GetDeviceName() == displayName;
-            });
+    std::vector<std::shared_ptr<NvapiOutput>> NvapiAdapterRegistry::enumerateOutputs() const {
+        std::vector<std::shared_ptr<NvapiOutput>> outputs;
+        for (auto i = 0U; i < m_nvapiAdapters.size(); i++)
+            m_nvapiAdapters[i]->InitializeOutputs(i, outputs);
 
-        return static_cast<short>(it != m_nvapiOutputs.end() ? std::distance(m_nvapiOutputs.begin(), it) : -1);
+        return outputs;
     }
 }
@@ -1,10 +1,26 @@
 #pragma once
 
 #include "../nvapi_private.h"
+#include "../util/util_handle.h"
+#include "../util/util_rcu.h"
+#include "nvapi_adapter_cache.h"
+#include "nvapi_adapter_probe.h"
+#include "nvapi_vulkan_dispatch.h"
+#include "nvapi_nvml.h"
 #include "nvapi_adapter.h"
 #include "nvapi_output.h"
+#include "nvapi_topology.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace dxvk {
+    /**
+     * \brief Adapters and outputs of one NvAPI initialization
+     *
+     * Published through an rcu::Pointer, callers hold a guard
+     * for as long as they use the registry or anything it returns.
+     */
     class NvapiAdapterRegistry {
 
     public:
@@ -16,15 +32,52 @@ namespace dxvk {
         [[nodiscard]] u_short GetAdapterCount() const;
         [[nodiscard]] NvapiAdapter* GetAdapter() const;
         [[nodiscard]] NvapiAdapter* GetAdapter(u_short index) const;
-        [[nodiscard]] bool IsAdapter(NvapiAdapter* handle) const;
+        [[nodiscard]] NvapiAdapter* GetAdapter(NvPhysicalGpuHandle handle) const;
+        [[nodiscard]] short GetAdapterIndex(NvPhysicalGpuHandle handle) const;
+        [[nodiscard]] NvPhysicalGpuHandle GetPhysicalGpuHandle(u_short index) const;
+
+        // Adapters sharing a LUID or a Vulkan device group form one logical GPU
+        [[nodiscard]] u_short GetLogicalGpuCount() const;
+        [[nodiscard]] short GetLogicalGpuIndex(NvLogicalGpuHandle handle) const;
+        [[nodiscard]] u_short GetLogicalGpuIndex(u_short adapterIndex) const;
+        [[nodiscard]] const std::vector<u_short>& GetLogicalGpuAdapters(u_short index) const;
+        [[nodiscard]] NvLogicalGpuHandle GetLogicalGpuHandle(u_short index) const;
 
+        // Current output snapshot, for callers that need several consistent lookups
+        [[nodiscard]] const NvapiTopology* GetTopology() const;
         [[nodiscard]] NvapiOutput* GetOutput(u_short index) const;
-        [[nodiscard]] bool IsOutput(NvapiOutput* handle) const;
-        [[nodiscard]] short GetPrimaryOutputId() const;
-        [[nodiscard]] short GetOutputId(const std::string& displayName) const;
+        [[nodiscard]] NvapiOutput* GetOutput(NvDisplayHandle handle) const;
+        [[nodiscard]] NvapiOutput* GetOutputById(uint32_t id) const;
+        [[nodiscard]] NvDisplayHandle GetDisplayHandle(u_short index) const;
+        [[nodiscard]] uint32_t GetPrimaryOutputId() const;
+        [[nodiscard]] uint32_t GetOutputId(std::string_view displayName) const;
 
     private:
+        void initializeLogicalGpus();
+        void startProbing();
+        [[nodiscard]] bool isRefreshDue() const;
+        void refresh() const;
+        [[nodiscard]] bool isTopologyCurrent(const NvapiTopology& topology) const;
+        [[nodiscard]] std::vector<std::shared_ptr<NvapiOutput>> enumerateOutputs() const;
+
+        uint32_t m_generation;
+        std::shared_ptr<NvapiVulkanDispatch> m_vk;
+        std::shared_ptr<NvapiNvml> m_nvml;
+        NvapiAdapterCache m_cache;
         std::vector<NvapiAdapter*> m_nvapiAdapters;
-        std::vector<NvapiOutput*> m_nvapiOutputs;
+        std::vector<std::vector<u_short>> m_logicalGpuAdapters;
+        std::vector<u_short> m_logicalGpuIndices;
+
+        // Multi-GPU systems probe adapters and their outputs in the background, one output list per adapter
+        mutable WorkPool m_probePool;
+        mutable std::vector<std::vector<std::shared_ptr<NvapiOutput>>> m_probedOutputs;
+
+        // Outputs are enumerated on first access and published as one immutable snapshot
+        mutable std::mutex m_topologyMutex;
+        mutable rcu::Pointer<NvapiTopology> m_topology;
+        mutable std::vector<std::unique_ptr<NvapiTopology>> m_retiredTopologies;
+
+        // Outputs are compared again by the first reader after every refresh interval, no thread outlives a call
+        mutable std::atomic<int64_t> m_nextRefresh{};
     };
 }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+namespace dxvk {
+    struct NvapiArchInfo {
+        NV_GPU_ARCHITECTURE_ID architecture;
+        NV_GPU_ARCH_IMPLEMENTATION_ID implementation;
+        NV_GPU_CHIP_REVISION revision;
+    };
+
+    struct NvapiDeviceTableEntry {
+        uint16_t deviceId;
+        NvapiArchInfo archInfo;
+        bool isMobile = false; // Notebook part, often named like the desktop part
+    };
+
+    // Not part of the bundled nvapi.h
+    constexpr auto NV_GPU_ARCH_IMPLEMENTATION_GA106 = static_cast<NV_GPU_ARCH_IMPLEMENTATION_ID>(0x00000006);
+
+    // NVIDIA PCI device IDs, sorted by device ID
+    constexpr NvapiDeviceTableEntry nvidiaDeviceTable[] = {
+        { 0x0fc2, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK107, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 630
+        { 0x0fc6, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK107, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 650
+        { 0x0fc8, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK107, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 740
+        { 0x1001, { NV_GPU_ARCHITECTURE_GK110, NV_GPU_ARCH_IMPLEMENTATION_GK110, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX TITAN Z
+        { 0x1003, { NV_GPU_ARCHITECTURE_GK110, NV_GPU_ARCH_IMPLEMENTATION_GK110, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX TITAN LE
+        { 0x1004, { NV_GPU_ARCHITECTURE_GK110, NV_GPU_ARCH_IMPLEMENTATION_GK110, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 780
+        { 0x1005, { NV_GPU_ARCHITECTURE_GK110, NV_GPU_ARCH_IMPLEMENTATION_GK110, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX TITAN
+        { 0x100a, { NV_GPU_ARCHITECTURE_GK110, NV_GPU_ARCH_IMPLEMENTATION_GK110, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 780 Ti
+        { 0x1180, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 680
+        { 0x1183, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 660 Ti
+        { 0x1184, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 770
+        { 0x1187, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 760
+        { 0x1189, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 670
+        { 0x11c0, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 660
+        { 0x11c6, { NV_GPU_ARCHITECTURE_GK100, NV_GPU_ARCH_IMPLEMENTATION_GK106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 650 Ti
+        { 0x1284, { NV_GPU_ARCHITECTURE_GK200, NV_GPU_ARCH_IMPLEMENTATION_GK208, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 630
+        { 0x1287, { NV_GPU_ARCHITECTURE_GK200, NV_GPU_ARCH_IMPLEMENTATION_GK208, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 730
+        { 0x1288, { NV_GPU_ARCHITECTURE_GK200, NV_GPU_ARCH_IMPLEMENTATION_GK208, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 720
+        { 0x13c0, { NV_GPU_ARCHITECTURE_GM200, NV_GPU_ARCH_IMPLEMENTATION_GM204, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 980
+        { 0x13c2, { NV_GPU_ARCHITECTURE_GM200, NV_GPU_ARCH_IMPLEMENTATION_GM204, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 970
+        { 0x1401, { NV_GPU_ARCHITECTURE_GM200, NV_GPU_ARCH_IMPLEMENTATION_GM206, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 960
+        { 0x1402, { NV_GPU_ARCHITECTURE_GM200, NV_GPU_ARCH_IMPLEMENTATION_GM206, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 950
+        { 0x15f7, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP100, NV_GPU_CHIP_REV_A01 } }, // Tesla P100 PCIe 12GB
+        { 0x15f8, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP100, NV_GPU_CHIP_REV_A01 } }, // Tesla P100 PCIe 16GB
+        { 0x1b00, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP102, NV_GPU_CHIP_REV_A01 } }, // TITAN X (Pascal)
+        { 0x1b02, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP102, NV_GPU_CHIP_REV_A01 } }, // TITAN Xp
+        { 0x1b06, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP102, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1080 Ti
+        { 0x1b80, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1080
+        { 0x1b81, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1070
+        { 0x1b82, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1070 Ti
+        { 0x1b83, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 6GB
+        { 0x1b84, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 3GB
+        { 0x1ba0, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1080 Mobile
+        { 0x1ba1, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1070 Mobile
+        { 0x1be0, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1080 Mobile
+        { 0x1be1, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1070 Mobile
+        { 0x1c02, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 3GB
+        { 0x1c03, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 6GB
+        { 0x1c04, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 5GB
+        { 0x1c06, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1060 6GB Rev. 2
+        { 0x1c20, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1060 Mobile
+        { 0x1c60, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1060 Mobile 6GB
+        { 0x1c81, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP107, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1050
+        { 0x1c82, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP107, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1050 Ti
+        { 0x1c83, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP107, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1050 3GB
+        { 0x1c8c, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP107, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1050 Ti Mobile
+        { 0x1c8d, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP107, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1050 Mobile
+        { 0x1d01, { NV_GPU_ARCHITECTURE_GP100, NV_GPU_ARCH_IMPLEMENTATION_GP108, NV_GPU_CHIP_REV_A01 } }, // GeForce GT 1030
+        { 0x1d81, { NV_GPU_ARCHITECTURE_GV100, NV_GPU_ARCH_IMPLEMENTATION_GV100, NV_GPU_CHIP_REV_A01 } }, // TITAN V
+        { 0x1db1, { NV_GPU_ARCHITECTURE_GV100, NV_GPU_ARCH_IMPLEMENTATION_GV100, NV_GPU_CHIP_REV_A01 } }, // Tesla V100 SXM2 16GB
+        { 0x1db4, { NV_GPU_ARCHITECTURE_GV100, NV_GPU_ARCH_IMPLEMENTATION_GV100, NV_GPU_CHIP_REV_A01 } }, // Tesla V100 PCIe 16GB
+        { 0x1e02, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU102, NV_GPU_CHIP_REV_A01 } }, // TITAN RTX
+        { 0x1e04, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2080 Ti
+        { 0x1e07, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2080 Ti Rev. A
+        { 0x1e81, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2080 SUPER
+        { 0x1e82, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2080
+        { 0x1e84, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2070 SUPER
+        { 0x1e87, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2080 Rev. A
+        { 0x1e89, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2060
+        { 0x1e90, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 2080 Mobile
+        { 0x1f02, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2070
+        { 0x1f03, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2060 12GB
+        { 0x1f06, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2060 SUPER
+        { 0x1f07, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2070 Rev. A
+        { 0x1f08, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 2060 Rev. A
+        { 0x1f10, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 2070 Mobile
+        { 0x1f11, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 2060 Mobile
+        { 0x1f82, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU117, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1650
+        { 0x1f91, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU117, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1650 Mobile
+        { 0x1f99, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU117, NV_GPU_CHIP_REV_A01 }, true }, // GeForce GTX 1650 Mobile
+        { 0x20b0, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA100, NV_GPU_CHIP_REV_A01 } }, // A100 SXM4 40GB
+        { 0x20f1, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA100, NV_GPU_CHIP_REV_A01 } }, // A100 PCIe 40GB
+        { 0x2182, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU116, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1660 Ti
+        { 0x2184, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU116, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1660
+        { 0x2187, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU116, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1650 SUPER
+        { 0x21c4, { NV_GPU_ARCHITECTURE_TU100, NV_GPU_ARCH_IMPLEMENTATION_TU116, NV_GPU_CHIP_REV_A01 } }, // GeForce GTX 1660 SUPER
+        { 0x2203, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3090 Ti
+        { 0x2204, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3090
+        { 0x2206, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3080
+        { 0x2208, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3080 Ti
+        { 0x220a, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3080 12GB
+        { 0x2216, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA102, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3080 LHR
+        { 0x2482, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3070 Ti
+        { 0x2484, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3070
+        { 0x2486, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3060 Ti
+        { 0x2488, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3070 LHR
+        { 0x2489, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3060 Ti LHR
+        { 0x249d, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 3070 Laptop GPU
+        { 0x24dc, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA104, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 3080 Laptop GPU
+        { 0x2503, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3060
+        { 0x2504, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3060 LHR
+        { 0x2507, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA106, NV_GPU_CHIP_REV_A01 } }, // GeForce RTX 3050
+        { 0x2520, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 3060 Laptop GPU
+        { 0x2560, { NV_GPU_ARCHITECTURE_GA100, NV_GPU_ARCH_IMPLEMENTATION_GA106, NV_GPU_CHIP_REV_A01 }, true }, // GeForce RTX 3060 Laptop GPU
+    };
+
+    constexpr bool isDeviceTableSorted() {
+        for (auto i = 1U; i < std::size(nvidiaDeviceTable); i++)
+            if (nvidiaDeviceTable[i - 1].deviceId >= nvidiaDeviceTable[i].deviceId)
+                return false;
+
+        return true;
+    }
+
+    static_assert(isDeviceTableSorted());
+
+    constexpr const NvapiDeviceTableEntry* findNvidiaDevice(uint32_t deviceId) {
+        // Lower bound search without data dependent branches, the loop count only depends on the table size
+        const auto* base = nvidiaDeviceTable;
+        auto count = std::size(nvidiaDeviceTable);
+        while (count > 1) {
+            auto half = count / 2;
+            base = base[half].deviceId <= deviceId ? base + half : base;
+            count -= half;
+        }
+
+        return base->deviceId == deviceId ? base : nullptr;
+    }
+
+    constexpr bool tryGetNvidiaArchInfo(uint32_t deviceId, NvapiArchInfo& archInfo) {
+        auto entry = findNvidiaDevice(deviceId);
+        if (entry == nullptr)
+            return false;
+
+        archInfo = entry->archInfo;
+        return true;
+    }
+
+    constexpr bool isNvidiaMobileDevice(uint32_t deviceId) {
+        auto entry = findNvidiaDevice(deviceId);
+        return entry != nullptr && entry->isMobile;
+    }
+}
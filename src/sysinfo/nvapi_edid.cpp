@@ -0,0 +1,397 @@
+#include "nvapi_edid.h"
+
+#include <cmath>
+#include <string>
+#include <string_view>
+
+namespace dxvk::edid {
+    constexpr uint8_t header[] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+    constexpr uint8_t ctaExtensionTag = 0x02;
+    constexpr uint8_t ctaVendorSpecificTag = 3;
+    constexpr uint8_t ctaExtendedTag = 7;
+    constexpr uint8_t ctaVendorSpecificVideoTag = 1;
+    constexpr uint8_t ctaHdrStaticMetadataTag = 6;
+    constexpr uint8_t ctaVideoCapabilityTag = 0;
+    constexpr uint8_t rangeLimitsDescriptorTag = 0xfd;
+    constexpr uint32_t amdOui = 0x00001a;
+    constexpr uint32_t hdmiOui = 0x000c03;
+    constexpr uint32_t dolbyOui = 0x00d046;
+
+    // Detailed timing descriptors are 18 bytes, the base block holds four of them
+    constexpr size_t descriptorSize = 18;
+    constexpr size_t baseDescriptorsOffset = 0x36;
+    constexpr size_t baseDescriptorsEnd = 0x7e;
+
+    static NvU16 toChromaticity(const uint8_t high, const uint8_t low) {
+        // EDID coordinates are 10 bit fractions of 1024
+        return static_cast<NvU16>((((high << 2) | low) * chromaticityScale) >> 10);
+    }
+
+    static double toLuminance(const uint8_t code) {
+        // CTA-861.3 luminance code values are 50 * 2^(cv / 32) cd/m^2
+        return 50.0 * std::pow(2.0, code / 32.0);
+    }
+
+    static void parseChromaticities(const std::vector<uint8_t>& data, NV_HDR_CAPABILITIES_V2& capabilities) {
+        // Bytes 0x19 and 0x1a hold the two low bits of every coordinate, 0x1b to 0x22 the high bits
+        auto rg = data[0x19];
+        auto bw = data[0x1a];
+        auto& display = capabilities.display_data;
+        display.displayPrimary_x0 = toChromaticity(data[0x1b], (rg >> 6) & 0x3);
+        display.displayPrimary_y0 = toChromaticity(data[0x1c], (rg >> 4) & 0x3);
+        display.displayPrimary_x1 = toChromaticity(data[0x1d], (rg >> 2) & 0x3);
+        display.displayPrimary_y1 = toChromaticity(data[0x1e], rg & 0x3);
+        display.displayPrimary_x2 = toChromaticity(data[0x1f], (bw >> 6) & 0x3);
+        display.displayPrimary_y2 = toChromaticity(data[0x20], (bw >> 4) & 0x3);
+        display.displayWhitePoint_x = toChromaticity(data[0x21], (bw >> 2) & 0x3);
+        display.displayWhitePoint_y = toChromaticity(data[0x22], bw & 0x3);
+    }
+
+    static void parseHdrStaticMetadata(const uint8_t* block, const size_t length, NV_HDR_CAPABILITIES_V2& capabilities) {
+        if (length < 2)
+            return;
+
+        capabilities.isTraditionalSdrGammaSupported = (block[0] & 0x1) != 0;
+        capabilities.isTraditionalHdrGammaSupported = (block[0] & 0x2) != 0;
+        capabilities.isST2084EotfSupported = (block[0] & 0x4) != 0;
+        capabilities.static_metadata_descriptor_id = NV_STATIC_METADATA_TYPE_1;
+
+        // Luminance values are optional, zero means unspecified
+        auto& display = capabilities.display_data;
+        auto maxLuminance = length > 2 && block[2] != 0 ? toLuminance(block[2]) : 0.0;
+        if (maxLuminance != 0.0)
+            display.desired_content_max_luminance = static_cast<NvU16>(std::min(maxLuminance, 65535.0));
+
+        if (length > 3 && block[3] != 0)
+            display.desired_content_max_frame_average_luminance = static_cast<NvU16>(std::min(toLuminance(block[3]), 65535.0));
+
+        // Minimum luminance is max * (cv / 255)^2 / 100 cd/m^2, NvAPI wants units of 0.0001 cd/m^2
+        if (length > 4 && maxLuminance != 0.0) {
+            auto ratio = block[4] / 255.0;
+            display.desired_content_min_luminance = static_cast<NvU16>(std::min(maxLuminance * ratio * ratio * 100.0, 65535.0));
+        }
+    }
+
+    static void parseDolbyVision(const uint8_t* block, const size_t length, NV_HDR_CAPABILITIES_V2& capabilities) {
+        // Layout follows the Dolby Vision VSVDB versions, luminance and primaries keep their encoding
+        if (length < 4)
+            return;
+
+        auto& dolby = capabilities.dv_static_metadata;
+        dolby = {};
+        dolby.VSVDB_version = block[0] >> 5;
+        dolby.supports_YUV422_12bit = block[0] & 0x1;
+
+        switch (dolby.VSVDB_version) {
+            case 0:
+                if (length < 17)
+                    return;
+
+                dolby.supports_2160p60hz = (block[0] >> 1) & 0x1;
+                dolby.supports_global_dimming = (block[0] >> 2) & 0x1;
+                dolby.cc_red_x = (block[1] >> 4) | (block[2] << 4);
+                dolby.cc_red_y = (block[1] & 0xf) | (block[3] << 4);
+                dolby.cc_green_x = (block[4] >> 4) | (block[5] << 4);
+                dolby.cc_green_y = (block[4] & 0xf) | (block[6] << 4);
+                dolby.cc_blue_x = (block[7] >> 4) | (block[8] << 4);
+                dolby.cc_blue_y = (block[7] & 0xf) | (block[9] << 4);
+                dolby.cc_white_x = (block[10] >> 4) | (block[11] << 4);
+                dolby.cc_white_y = (block[10] & 0xf) | (block[12] << 4);
+                dolby.target_min_luminance = (block[13] >> 4) | (block[14] << 4);
+                dolby.target_max_luminance = (block[13] & 0xf) | (block[15] << 4);
+                dolby.dm_version = block[16];
+                break;
+            case 1:
+                dolby.supports_2160p60hz = (block[0] >> 1) & 0x1;
+                dolby.dm_version = (((block[0] >> 2) & 0x7) + 2) << 4;
+                dolby.supports_global_dimming = block[1] & 0x1;
+                dolby.target_max_luminance = block[1] >> 1;
+                dolby.colorimetry = block[2] & 0x1;
+                dolby.target_min_luminance = block[2] >> 1;
+                dolby.interface_supported_by_sink = block[3] & 0x3;
+
+                // Only the long form carries primaries as plain 8 bit values
+                if (length == 10) {
+                    dolby.cc_red_x = block[4];
+                    dolby.cc_red_y = block[5];
+                    dolby.cc_green_x = block[6];
+                    dolby.cc_green_y = block[7];
+                    dolby.cc_blue_x = block[8];
+                    dolby.cc_blue_y = block[9];
+                }
+                break;
+            case 2:
+                if (length < 5)
+                    return;
+
+                dolby.supports_backlight_control = (block[0] >> 1) & 0x1;
+                dolby.dm_version = (((block[0] >> 2) & 0x7) + 2) << 4;
+                dolby.backlt_min_luma = block[1] & 0x3;
+                dolby.supports_global_dimming = (block[1] >> 2) & 0x1;
+                dolby.target_min_luminance = block[1] >> 3;
+                dolby.interface_supported_by_sink = block[2] & 0x3;
+                dolby.target_max_luminance = block[2] >> 3;
+                dolby.supports_10b_12b_444 = ((block[3] & 0x1) << 1) | (block[4] & 0x1);
+                break;
+            default:
+                return;
+        }
+
+        capabilities.isDolbyVisionSupported = true;
+    }
+
+    static bool isValid(const std::vector<uint8_t>& data) {
+        return data.size() >= blockSize && std::equal(std::begin(header), std::end(header), data.begin());
+    }
+
+    static uint32_t toOui(const uint8_t* bytes) {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+    }
+
+    template<typename F>
+    static void forEachCtaDataBlock(const std::vector<uint8_t>& data, F&& callback) {
+        for (auto block = blockSize; block + blockSize <= data.size(); block += blockSize) {
+            auto extension = data.data() + block;
+            if (extension[0] != ctaExtensionTag)
+                continue;
+
+            // Data blocks start at byte 4 and end where the detailed timing descriptors begin
+            auto end = std::min<size_t>(extension[2], blockSize - 1);
+            for (size_t offset = 4; offset < end;) {
+                auto tag = extension[offset] >> 5;
+                auto length = static_cast<size_t>(extension[offset] & 0x1f);
+                auto payload = extension + offset + 1;
+                offset += length + 1;
+
+                if (offset <= end && length > 0)
+                    callback(tag, payload, length);
+            }
+        }
+    }
+
+    static bool parseDetailedTiming(const uint8_t* descriptor, NV_TIMING& timing) {
+        // A zero pixel clock marks a display descriptor instead
+        auto pixelClock = static_cast<uint32_t>(descriptor[0] | (descriptor[1] << 8));
+        if (pixelClock == 0)
+            return false;
+
+        auto hBlank = descriptor[3] | ((descriptor[4] & 0x0f) << 8);
+        auto vBlank = descriptor[6] | ((descriptor[7] & 0x0f) << 8);
+
+        timing = {};
+        timing.HVisible = descriptor[2] | ((descriptor[4] & 0xf0) << 4);
+        timing.HBorder = descriptor[15];
+        timing.HFrontPorch = descriptor[8] | ((descriptor[11] & 0xc0) << 2);
+        timing.HSyncWidth = descriptor[9] | ((descriptor[11] & 0x30) << 4);
+        timing.HTotal = timing.HVisible + hBlank;
+        timing.VVisible = descriptor[5] | ((descriptor[7] & 0xf0) << 4);
+        timing.VBorder = descriptor[16];
+        timing.VFrontPorch = (descriptor[10] >> 4) | ((descriptor[11] & 0x0c) << 2);
+        timing.VSyncWidth = (descriptor[10] & 0x0f) | ((descriptor[11] & 0x03) << 4);
+        timing.VTotal = timing.VVisible + vBlank;
+        timing.interlaced = (descriptor[17] >> 7) & 0x1;
+
+        // Polarities are only defined for digital separate sync, EDID flags positive while NvAPI flags negative
+        if ((descriptor[17] & 0x18) == 0x18) {
+            timing.HSyncPol = (descriptor[17] & 0x02) == 0;
+            timing.VSyncPol = (descriptor[17] & 0x04) == 0;
+        }
+
+        // Both use units of 10 kHz for the pixel clock
+        timing.pclk = pixelClock;
+
+        if (timing.HTotal != 0 && timing.VTotal != 0) {
+            timing.etc.rrx1k = static_cast<NvU32>(pixelClock * 10000000ULL / (static_cast<uint64_t>(timing.HTotal) * timing.VTotal));
+            timing.etc.rr = static_cast<NvU16>((timing.etc.rrx1k + 500) / 1000);
+        }
+
+        // Image size in millimeters
+        timing.etc.aspect = ((descriptor[12] | ((descriptor[14] & 0xf0) << 4)) << 16) | (descriptor[13] | ((descriptor[14] & 0x0f) << 8));
+        timing.etc.rep = 1;
+        timing.etc.status = NV_TIMING_OVERRIDE_EDID;
+        return true;
+    }
+
+    static void parseHdmiVsdb(const uint8_t* payload, const size_t length, NV_MONITOR_CAPS_VSDB& vsdb) {
+        // Bytes up to the content types map 1:1, latencies, VICs and 3D formats only follow if flagged
+        auto raw = reinterpret_cast<uint8_t*>(&vsdb);
+        vsdb = {};
+        std::copy(payload + 3, payload + std::min<size_t>(length, 8), raw);
+
+        auto offset = size_t(8);
+        if (vsdb.hasLatencyField && offset + 2 <= length) {
+            vsdb.videoLatency = payload[offset++];
+            vsdb.audioLatency = payload[offset++];
+        }
+
+        if (vsdb.hasInterlacedLatencyField && offset + 2 <= length) {
+            vsdb.interlacedVideoLatency = payload[offset++];
+            vsdb.interlacedAudioLatency = payload[offset++];
+        }
+
+        if (!vsdb.hasVicEntries || offset + 2 > length)
+            return;
+
+        raw[9] = payload[offset++];
+        raw[10] = payload[offset++];
+
+        auto vicLength = std::min<size_t>({vsdb.hdmiVicLength, sizeof(vsdb.hdmi_vic), length - offset});
+        std::copy(payload + offset, payload + offset + vicLength, vsdb.hdmi_vic);
+        offset += vicLength;
+
+        auto length3d = std::min<size_t>({vsdb.hdmi3dLength, sizeof(vsdb.hdmi_3d), length - offset});
+        std::copy(payload + offset, payload + offset + length3d, vsdb.hdmi_3d);
+    }
+
+    static void parseVcdb(const uint8_t value, NV_MONITOR_CAPS_VCDB& vcdb) {
+        // Bit order is reversed compared to the data block
+        vcdb.quantizationRangeYcc = (value >> 7) & 0x1;
+        vcdb.quantizationRangeRgb = (value >> 6) & 0x1;
+        vcdb.scanInfoPreferredVideoFormat = (value >> 4) & 0x3;
+        vcdb.scanInfoITVideoFormats = (value >> 2) & 0x3;
+        vcdb.scanInfoCEVideoFormats = value & 0x3;
+    }
+
+    static NV_MONITOR_CONN_TYPE toConnectorType(const uint8_t videoInput) {
+        if (!(videoInput & 0x80))
+            return NV_MONITOR_CONN_TYPE_VGA;
+
+        // EDID 1.4 digital interface standard
+        switch (videoInput & 0x0f) {
+            case 0x1:
+                return NV_MONITOR_CONN_TYPE_DVI;
+            case 0x2:
+            case 0x3:
+                return NV_MONITOR_CONN_TYPE_HDMI;
+            case 0x5:
+                return NV_MONITOR_CONN_TYPE_DP;
+            default:
+                return NV_MONITOR_CONN_TYPE_UNKNOWN;
+        }
+    }
+
+    static void parseRefreshRateRange(const std::vector<uint8_t>& data, uint32_t& minRefreshRate, uint32_t& maxRefreshRate) {
+        minRefreshRate = 0;
+        maxRefreshRate = 0;
+
+        // FreeSync displays announce their range in the AMD vendor specific data block
+        forEachCtaDataBlock(data, [&](const uint8_t tag, const uint8_t* payload, const size_t length) {
+            if (tag == ctaVendorSpecificTag && length >= 7 && toOui(payload) == amdOui) {
+                minRefreshRate = payload[5];
+                maxRefreshRate = payload[6];
+            }
+        });
+
+        // VESA Adaptive-Sync displays set continuous frequency and list their range in the range limits descriptor
+        // with only range limits and no timing formula. Before EDID 1.4 the same bit meant GTF support, and
+        // fixed refresh rate displays list their supported range there as well.
+        if (maxRefreshRate == 0 && data[0x13] >= 4 && (data[0x18] & 0x1)) {
+            for (auto offset = 0x36U; offset + 18 <= 0x7e; offset += 18) {
+                auto descriptor = data.data() + offset;
+                if (descriptor[0] != 0 || descriptor[1] != 0 || descriptor[3] != rangeLimitsDescriptorTag || descriptor[10] != 0x01)
+                    continue;
+
+                // Rate offsets of 255 Hz for the maximum, and for the minimum only along with the maximum
+                minRefreshRate = descriptor[5] + ((descriptor[4] & 0x3) == 0x3 ? 255 : 0);
+                maxRefreshRate = descriptor[6] + ((descriptor[4] & 0x2) ? 255 : 0);
+                break;
+            }
+        }
+    }
+
+    std::vector<uint8_t> read(const WCHAR* displayName) {
+        // The interface name looks like \\?\DISPLAY#GSM5B08#5&2a1b3c4d&0&UID4353#{e6f07b5f-ee97-4a90-b076-33f57bf4eaa7},
+        // without prefix and class GUID it is the device instance path below the Enum key
+        DISPLAY_DEVICEW device{};
+        device.cb = sizeof(device);
+        if (!::EnumDisplayDevicesW(displayName, 0, &device, EDD_GET_DEVICE_INTERFACE_NAME))
+            return {};
+
+        std::wstring instancePath = device.DeviceID;
+        constexpr std::wstring_view prefix = L"\\\\?\\";
+        auto classGuid = instancePath.rfind(L'#');
+        if (instancePath.rfind(prefix, 0) != 0 || classGuid == std::wstring::npos)
+            return {};
+
+        instancePath = instancePath.substr(prefix.size(), classGuid - prefix.size());
+        std::replace(instancePath.begin(), instancePath.end(), L'#', L'\\');
+
+        auto key = L"SYSTEM\\CurrentControlSet\\Enum\\" + instancePath + L"\\Device Parameters";
+        DWORD size = 0;
+        if (::RegGetValueW(HKEY_LOCAL_MACHINE, key.c_str(), L"EDID", RRF_RT_REG_BINARY, nullptr, nullptr, &size) != ERROR_SUCCESS || size < blockSize)
+            return {};
+
+        std::vector<uint8_t> data(size);
+        if (::RegGetValueW(HKEY_LOCAL_MACHINE, key.c_str(), L"EDID", RRF_RT_REG_BINARY, nullptr, data.data(), &size) != ERROR_SUCCESS)
+            return {};
+
+        data.resize(size - size % blockSize);
+        return data;
+    }
+
+    bool parseHdrCapabilities(const std::vector<uint8_t>& data, NV_HDR_CAPABILITIES_V2& capabilities) {
+        if (!isValid(data))
+            return false;
+
+        parseChromaticities(data, capabilities);
+
+        forEachCtaDataBlock(data, [&capabilities](const uint8_t tag, const uint8_t* payload, const size_t length) {
+            if (tag != ctaExtendedTag)
+                return;
+
+            if (payload[0] == ctaHdrStaticMetadataTag)
+                parseHdrStaticMetadata(payload + 1, length - 1, capabilities);
+            else if (payload[0] == ctaVendorSpecificVideoTag && length >= 4 && toOui(payload + 1) == dolbyOui)
+                parseDolbyVision(payload + 4, length - 4, capabilities);
+        });
+
+        return true;
+    }
+
+    bool parseInfo(const std::vector<uint8_t>& data, NvapiEdidInfo& info) {
+        if (!isValid(data))
+            return false;
+
+        info = {};
+        info.connectorType = toConnectorType(data[0x14]);
+        info.isDigital = (data[0x14] & 0x80) != 0;
+
+        // FNV-1a
+        info.id = 0x811c9dc5;
+        for (auto byte : data)
+            info.id = (info.id ^ byte) * 0x01000193;
+
+        // The first detailed timing of the base block is the preferred one
+        NV_TIMING timing;
+        for (auto offset = baseDescriptorsOffset; offset + descriptorSize <= baseDescriptorsEnd; offset += descriptorSize) {
+            if (parseDetailedTiming(data.data() + offset, timing))
+                info.timings.push_back(timing);
+        }
+
+        for (auto block = blockSize; block + blockSize <= data.size(); block += blockSize) {
+            auto extension = data.data() + block;
+            if (extension[0] != ctaExtensionTag || extension[2] < 4)
+                continue;
+
+            // Detailed timings follow the data blocks up to the checksum
+            for (auto offset = static_cast<size_t>(extension[2]); offset + descriptorSize < blockSize; offset += descriptorSize) {
+                if (parseDetailedTiming(extension + offset, timing))
+                    info.timings.push_back(timing);
+            }
+        }
+
+        forEachCtaDataBlock(data, [&info](const uint8_t tag, const uint8_t* payload, const size_t length) {
+            if (tag == ctaVendorSpecificTag && length >= 5 && toOui(payload) == hdmiOui) {
+                parseHdmiVsdb(payload, length, info.vsdb);
+                info.hasVsdb = true;
+                info.connectorType = NV_MONITOR_CONN_TYPE_HDMI;
+            } else if (tag == ctaExtendedTag && length >= 2 && payload[0] == ctaVideoCapabilityTag) {
+                parseVcdb(payload[1], info.vcdb);
+                info.hasVcdb = true;
+            }
+        });
+
+        parseRefreshRateRange(data, info.minRefreshRate, info.maxRefreshRate);
+        return true;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <vector>
+
+namespace dxvk {
+    /**
+     * \brief Parsed EDID
+     *
+     * Everything NvAPI reports about a display, extracted once so
+     * that queries do not touch the raw EDID again.
+     */
+    struct NvapiEdidInfo {
+        uint32_t id;                    // Hash of the raw EDID, changes along with its contents
+        NV_MONITOR_CONN_TYPE connectorType = NV_MONITOR_CONN_TYPE_UNKNOWN;
+        bool isDigital;                 // Digital video input, analog inputs report NV_MONITOR_CONN_TYPE_VGA
+        std::vector<NV_TIMING> timings; // Detailed timings, the preferred one first
+        uint32_t minRefreshRate;        // Hz, from the AMD vendor specific data block or the range limits descriptor, 0 if unknown
+        uint32_t maxRefreshRate;        // Hz, 0 if unknown
+        bool hasVsdb;
+        NV_MONITOR_CAPS_VSDB vsdb;      // HDMI vendor specific data block
+        bool hasVcdb;
+        NV_MONITOR_CAPS_VCDB vcdb;      // CTA video capability data block
+    };
+}
+
+namespace dxvk::edid {
+    // EDIDs consist of 128 byte blocks, the base block followed by extension blocks
+    constexpr size_t blockSize = 128;
+
+    // NvAPI chromaticity coordinates map [0.0 - 1.0] to [0 - 50000]
+    constexpr uint32_t chromaticityScale = 50000;
+
+    // Raw EDID of the monitor behind a GDI display name like \\.\DISPLAY1, empty if unknown
+    std::vector<uint8_t> read(const WCHAR* displayName);
+
+    // Fills in HDR capabilities from the base block primaries and the CTA-861
+    // HDR static metadata and Dolby Vision data blocks, fields not present in
+    // the EDID are left untouched. ST2084 support is what the display can do,
+    // not whether HDR is enabled. Returns false for anything not an EDID.
+    bool parseHdrCapabilities(const std::vector<uint8_t>& data, NV_HDR_CAPABILITIES_V2& capabilities);
+
+    // Connector, detailed timings, refresh range and HDMI capabilities, returns false for anything not an EDID
+    bool parseInfo(const std::vector<uint8_t>& data, NvapiEdidInfo& info);
+}
@@ -0,0 +1,67 @@
+#include "nvapi_nvml.h"
+#include "../util/util_string.h"
+#include "../util/util_log.h"
+
+namespace dxvk {
+    NvapiNvml::NvapiNvml() = default;
+
+    NvapiNvml::~NvapiNvml() {
+        if (m_available)
+            m_nvmlShutdown();
+
+        if (m_nvmlModule != nullptr)
+            FreeLibrary(m_nvmlModule);
+    }
+
+    bool NvapiNvml::IsAvailable() {
+        std::call_once(m_loaded, [this] { load(); });
+        return m_available;
+    }
+
+    void NvapiNvml::load() {
+        const auto nvmlModuleName = "nvml.dll";
+        m_nvmlModule = ::LoadLibraryA(nvmlModuleName);
+        if (m_nvmlModule == nullptr) {
+            log::write(str::format("Loading ", nvmlModuleName, " failed with error code ", ::GetLastError(), ", GPU telemetry is not available"));
+            return;
+        }
+
+        PFN_nvmlInit_v2 nvmlInit_v2;
+        if (!resolve(nvmlInit_v2, "nvmlInit_v2")
+            || !resolve(m_nvmlShutdown, "nvmlShutdown")
+            || !resolve(nvmlDeviceGetHandleByPciBusId_v2, "nvmlDeviceGetHandleByPciBusId_v2")
+            || !resolve(nvmlDeviceGetUtilizationRates, "nvmlDeviceGetUtilizationRates")
+            || !resolve(nvmlDeviceGetEncoderUtilization, "nvmlDeviceGetEncoderUtilization")
+            || !resolve(nvmlDeviceGetDecoderUtilization, "nvmlDeviceGetDecoderUtilization")
+            || !resolve(nvmlDeviceGetPerformanceState, "nvmlDeviceGetPerformanceState")
+            || !resolve(nvmlDeviceGetClockInfo, "nvmlDeviceGetClockInfo")
+            || !resolve(nvmlDeviceGetMaxClockInfo, "nvmlDeviceGetMaxClockInfo")
+            || !resolve(nvmlDeviceGetDefaultApplicationsClock, "nvmlDeviceGetDefaultApplicationsClock")
+            || !resolve(nvmlDeviceGetTemperature, "nvmlDeviceGetTemperature")
+            || !resolve(nvmlDeviceGetTemperatureThreshold, "nvmlDeviceGetTemperatureThreshold"))
+            return;
+
+        // Not every NVML implementation knows about throttle reasons
+        resolve(nvmlDeviceGetCurrentClocksThrottleReasons, "nvmlDeviceGetCurrentClocksThrottleReasons");
+
+        auto result = nvmlInit_v2();
+        if (result != NVML_SUCCESS) {
+            log::write(str::format("Initializing NVML failed with error code ", result));
+            return;
+        }
+
+        m_available = true;
+    }
+
+    template<typename T>
+    bool NvapiNvml::resolve(T& function, const char* name) {
+        function = reinterpret_cast<T>(
+            reinterpret_cast<void*>(
+                GetProcAddress(m_nvmlModule, name)));
+
+        if (function == nullptr)
+            log::write(str::format("Resolving ", name, " failed"));
+
+        return function != nullptr;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <mutex>
+
+namespace dxvk {
+    // Subset of nvml.h, which is not part of this tree
+    using nvmlReturn_t = int;
+    using nvmlDevice_t = struct nvmlDevice_st*;
+    using nvmlPstates_t = int;
+
+    constexpr nvmlReturn_t NVML_SUCCESS = 0;
+    constexpr nvmlPstates_t NVML_PSTATE_UNKNOWN = 32;
+
+    struct nvmlUtilization_t {
+        unsigned int gpu;
+        unsigned int memory;
+    };
+
+    enum nvmlClockType_t {
+        NVML_CLOCK_GRAPHICS = 0,
+        NVML_CLOCK_SM = 1,
+        NVML_CLOCK_MEM = 2,
+        NVML_CLOCK_VIDEO = 3,
+    };
+
+    enum nvmlTemperatureSensors_t {
+        NVML_TEMPERATURE_GPU = 0,
+    };
+
+    enum nvmlTemperatureThresholds_t {
+        NVML_TEMPERATURE_THRESHOLD_SHUTDOWN = 0,
+        NVML_TEMPERATURE_THRESHOLD_SLOWDOWN = 1,
+    };
+
+    constexpr unsigned long long nvmlClocksThrottleReasonApplicationsClocksSetting = 0x0000000000000002ULL;
+    constexpr unsigned long long nvmlClocksThrottleReasonSwPowerCap = 0x0000000000000004ULL;
+    constexpr unsigned long long nvmlClocksThrottleReasonHwSlowdown = 0x0000000000000008ULL;
+    constexpr unsigned long long nvmlClocksThrottleReasonSwThermalSlowdown = 0x0000000000000020ULL;
+    constexpr unsigned long long nvmlClocksThrottleReasonHwThermalSlowdown = 0x0000000000000040ULL;
+    constexpr unsigned long long nvmlClocksThrottleReasonHwPowerBrakeSlowdown = 0x0000000000000080ULL;
+
+    using PFN_nvmlInit_v2 = nvmlReturn_t (*)();
+    using PFN_nvmlShutdown = nvmlReturn_t (*)();
+    using PFN_nvmlDeviceGetHandleByPciBusId_v2 = nvmlReturn_t (*)(const char*, nvmlDevice_t*);
+    using PFN_nvmlDeviceGetUtilizationRates = nvmlReturn_t (*)(nvmlDevice_t, nvmlUtilization_t*);
+    using PFN_nvmlDeviceGetEncoderUtilization = nvmlReturn_t (*)(nvmlDevice_t, unsigned int*, unsigned int*);
+    using PFN_nvmlDeviceGetDecoderUtilization = nvmlReturn_t (*)(nvmlDevice_t, unsigned int*, unsigned int*);
+    using PFN_nvmlDeviceGetPerformanceState = nvmlReturn_t (*)(nvmlDevice_t, nvmlPstates_t*);
+    using PFN_nvmlDeviceGetClockInfo = nvmlReturn_t (*)(nvmlDevice_t, nvmlClockType_t, unsigned int*);
+    using PFN_nvmlDeviceGetMaxClockInfo = nvmlReturn_t (*)(nvmlDevice_t, nvmlClockType_t, unsigned int*);
+    using PFN_nvmlDeviceGetDefaultApplicationsClock = nvmlReturn_t (*)(nvmlDevice_t, nvmlClockType_t, unsigned int*);
+    using PFN_nvmlDeviceGetTemperature = nvmlReturn_t (*)(nvmlDevice_t, nvmlTemperatureSensors_t, unsigned int*);
+    using PFN_nvmlDeviceGetTemperatureThreshold = nvmlReturn_t (*)(nvmlDevice_t, nvmlTemperatureThresholds_t, unsigned int*);
+    using PFN_nvmlDeviceGetCurrentClocksThrottleReasons = nvmlReturn_t (*)(nvmlDevice_t, unsigned long long*);
+
+    /**
+     * \brief NVML dispatch table
+     *
+     * Loads nvml.dll, e.g. provided by wine-nvml, on first use
+     * only since initializing NVML is expensive. Shared between
+     * the registry and its adapters like the Vulkan dispatch.
+     */
+    class NvapiNvml {
+
+    public:
+        NvapiNvml();
+        ~NvapiNvml();
+
+        // Loads NVML on first use, which is slow, only call this from a background thread
+        [[nodiscard]] bool IsAvailable();
+
+        PFN_nvmlDeviceGetHandleByPciBusId_v2 nvmlDeviceGetHandleByPciBusId_v2{};
+        PFN_nvmlDeviceGetUtilizationRates nvmlDeviceGetUtilizationRates{};
+        PFN_nvmlDeviceGetEncoderUtilization nvmlDeviceGetEncoderUtilization{};
+        PFN_nvmlDeviceGetDecoderUtilization nvmlDeviceGetDecoderUtilization{};
+        PFN_nvmlDeviceGetPerformanceState nvmlDeviceGetPerformanceState{};
+        PFN_nvmlDeviceGetClockInfo nvmlDeviceGetClockInfo{};
+        PFN_nvmlDeviceGetMaxClockInfo nvmlDeviceGetMaxClockInfo{};
+        PFN_nvmlDeviceGetDefaultApplicationsClock nvmlDeviceGetDefaultApplicationsClock{};
+        PFN_nvmlDeviceGetTemperature nvmlDeviceGetTemperature{};
+        PFN_nvmlDeviceGetTemperatureThreshold nvmlDeviceGetTemperatureThreshold{};
+        PFN_nvmlDeviceGetCurrentClocksThrottleReasons nvmlDeviceGetCurrentClocksThrottleReasons{}; // Optional
+
+    private:
+        void load();
+
+        template<typename T>
+        bool resolve(T& function, const char* name);
+
+        std::once_flag m_loaded;
+        HMODULE m_nvmlModule{};
+        PFN_nvmlShutdown m_nvmlShutdown{};
+        bool m_available{};
+    };
+}
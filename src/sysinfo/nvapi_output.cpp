@@ -1,9 +1,8 @@
 #include "nvapi_output.h"
 #include "../util/util_string.h"
-#include "../util/util_log.h"
 
 namespace dxvk {
-    NvapiOutput::NvapiOutput(const uintptr_t parent) {
+    NvapiOutput::NvapiOutput(const u_short parent) {
         m_parent = parent;
     }
 
@@ -11,19 +10,57 @@ namespace dxvk {
 
     void NvapiOutput::Initialize(Com<IDXGIOutput>& dxgiOutput) {
         DXGI_OUTPUT_DESC desc;
+        initializeMode(dxgiOutput, desc);
+
+        m_edid = edid::read(desc.DeviceName);
+        edid::parseInfo(m_edid, m_edidInfo);
+        initializeHdrCapabilities(dxgiOutput);
+
+        // Same heuristic as Linux DRM drivers, a range narrower than 10 Hz is no use for variable refresh rate
+        m_isVrrCapable = m_edidInfo.minRefreshRate != 0 && m_edidInfo.maxRefreshRate > m_edidInfo.minRefreshRate + 10;
+    }
+
+    bool NvapiOutput::IsCurrent(Com<IDXGIOutput>& dxgiOutput) const {
+        // Only the cheap DXGI description and the current mode, the EDID is tied to the monitor handle
+        // and DXVK's color space follows DXVK_HDR, which does not change while the process runs
+        DXGI_OUTPUT_DESC desc;
+        NvapiOutput output(m_parent);
+        output.initializeMode(dxgiOutput, desc);
+
+        return isSameMode(output);
+    }
+
+    void NvapiOutput::initializeMode(Com<IDXGIOutput>& dxgiOutput, DXGI_OUTPUT_DESC& desc) {
         dxgiOutput->GetDesc(&desc);
 
         m_deviceName = str::fromws(desc.DeviceName);
-        log::write(str::format("NvAPI Output: ", m_deviceName));
+        m_monitor = desc.Monitor;
+        m_desktopCoordinates = desc.DesktopCoordinates;
+        m_rotation = desc.Rotation;
 
         MONITORINFO info;
         info.cbSize = sizeof(MONITORINFO);
         GetMonitorInfo(desc.Monitor, &info);
 
         m_isPrimary = (info.dwFlags & MONITORINFOF_PRIMARY);
+
+        // DXGI only knows the desktop area, depth and refresh rate come from GDI
+        m_currentMode.width = m_desktopCoordinates.right - m_desktopCoordinates.left;
+        m_currentMode.height = m_desktopCoordinates.bottom - m_desktopCoordinates.top;
+        m_currentMode.bitsPerPixel = 32;
+
+        DEVMODEW devMode{};
+        devMode.dmSize = sizeof(devMode);
+        if (::EnumDisplaySettingsW(desc.DeviceName, ENUM_CURRENT_SETTINGS, &devMode)) {
+            m_currentMode.width = devMode.dmPelsWidth;
+            m_currentMode.height = devMode.dmPelsHeight;
+            m_currentMode.bitsPerPixel = devMode.dmBitsPerPel;
+            m_currentMode.refreshRate = devMode.dmDisplayFrequency > 1 ? devMode.dmDisplayFrequency : 0;
+            m_currentMode.interlaced = (devMode.dmDisplayFlags & DM_INTERLACED) != 0;
+        }
     }
 
-    uintptr_t NvapiOutput::GetParent() const {
+    u_short NvapiOutput::GetParent() const {
         return m_parent;
     }
 
@@ -34,4 +71,102 @@ namespace dxvk {
     bool NvapiOutput::IsPrimary() const {
         return m_isPrimary;
     }
+
+    const RECT& NvapiOutput::GetDesktopCoordinates() const {
+        return m_desktopCoordinates;
+    }
+
+    DXGI_MODE_ROTATION NvapiOutput::GetRotation() const {
+        return m_rotation;
+    }
+
+    const NvapiOutputMode& NvapiOutput::GetCurrentMode() const {
+        return m_currentMode;
+    }
+
+    const NV_HDR_CAPABILITIES_V2& NvapiOutput::GetHdrCapabilities() const {
+        return m_hdrCapabilities;
+    }
+
+    const std::vector<uint8_t>& NvapiOutput::GetEdid() const {
+        return m_edid;
+    }
+
+    const NvapiEdidInfo& NvapiOutput::GetEdidInfo() const {
+        return m_edidInfo;
+    }
+
+    bool NvapiOutput::IsVrrCapable() const {
+        return m_isVrrCapable;
+    }
+
+    bool NvapiOutput::IsEquivalent(const NvapiOutput& other) const {
+        return isSameMode(other)
+            && m_colorSpace == other.m_colorSpace
+            && m_edid == other.m_edid;
+    }
+
+    bool NvapiOutput::isSameMode(const NvapiOutput& other) const {
+        // Same connector in the same desktop configuration
+        return m_parent == other.m_parent
+            && m_deviceName == other.m_deviceName
+            && m_isPrimary == other.m_isPrimary
+            && m_monitor == other.m_monitor
+            && m_desktopCoordinates.left == other.m_desktopCoordinates.left
+            && m_desktopCoordinates.top == other.m_desktopCoordinates.top
+            && m_desktopCoordinates.right == other.m_desktopCoordinates.right
+            && m_desktopCoordinates.bottom == other.m_desktopCoordinates.bottom
+            && m_rotation == other.m_rotation
+            && m_currentMode.width == other.m_currentMode.width
+            && m_currentMode.height == other.m_currentMode.height
+            && m_currentMode.bitsPerPixel == other.m_currentMode.bitsPerPixel
+            && m_currentMode.refreshRate == other.m_currentMode.refreshRate
+            && m_currentMode.interlaced == other.m_currentMode.interlaced;
+    }
+
+    void NvapiOutput::initializeHdrCapabilities(Com<IDXGIOutput>& dxgiOutput) {
+        // Every display handles SDR content, unless its EDID says otherwise
+        m_hdrCapabilities.version = NV_HDR_CAPABILITIES_VER2;
+        m_hdrCapabilities.isTraditionalSdrGammaSupported = true;
+        edid::parseHdrCapabilities(m_edid, m_hdrCapabilities);
+
+        // HDR10 swapchains can only be created while HDR is enabled, e.g. through DXVK_HDR, which is
+        // exactly when DXGI reports an ST2084 color space, the EDID only knows what the display could do
+        m_hdrCapabilities.isST2084EotfSupported = false;
+
+        // DXGI reflects what Windows made of the EDID and any calibration, prefer its values where known
+        Com<IDXGIOutput6> dxgiOutput6;
+        DXGI_OUTPUT_DESC1 desc1;
+        if (FAILED(dxgiOutput->QueryInterface(IID_PPV_ARGS(&dxgiOutput6))) || FAILED(dxgiOutput6->GetDesc1(&desc1)))
+            return;
+
+        m_colorSpace = desc1.ColorSpace;
+        m_hdrCapabilities.isST2084EotfSupported = m_colorSpace == DXGI_COLOR_SPACE_RGB_FULL_G2084_NONE_P2020;
+
+        auto toChromaticity = [](const FLOAT value) {
+            return static_cast<NvU16>(std::clamp(value, 0.0f, 1.0f) * edid::chromaticityScale);
+        };
+
+        auto& display = m_hdrCapabilities.display_data;
+        if (desc1.RedPrimary[0] != 0.0f || desc1.GreenPrimary[0] != 0.0f || desc1.BluePrimary[0] != 0.0f) {
+            display.displayPrimary_x0 = toChromaticity(desc1.RedPrimary[0]);
+            display.displayPrimary_y0 = toChromaticity(desc1.RedPrimary[1]);
+            display.displayPrimary_x1 = toChromaticity(desc1.GreenPrimary[0]);
+            display.displayPrimary_y1 = toChromaticity(desc1.GreenPrimary[1]);
+            display.displayPrimary_x2 = toChromaticity(desc1.BluePrimary[0]);
+            display.displayPrimary_y2 = toChromaticity(desc1.BluePrimary[1]);
+            display.displayWhitePoint_x = toChromaticity(desc1.WhitePoint[0]);
+            display.displayWhitePoint_y = toChromaticity(desc1.WhitePoint[1]);
+        }
+
+        // Maximum luminances are in cd/m^2, the minimum in units of 0.0001 cd/m^2
+        if (desc1.MaxLuminance > 0.0f)
+            display.desired_content_max_luminance = static_cast<NvU16>(std::min(desc1.MaxLuminance, 65535.0f));
+
+        if (desc1.MaxFullFrameLuminance > 0.0f)
+            display.desired_content_max_frame_average_luminance = static_cast<NvU16>(std::min(desc1.MaxFullFrameLuminance, 65535.0f));
+
+        if (desc1.MinLuminance > 0.0f)
+            display.desired_content_min_luminance = static_cast<NvU16>(std::min(desc1.MinLuminance * 10000.0f, 65535.0f));
+    }
 }
@@ -2,22 +2,56 @@
 
 #include "../nvapi_private.h"
 #include "../util/com_pointer.h"
+#include "nvapi_edid.h"
+
+#include <dxgi1_6.h>
+#include <vector>
 
 namespace dxvk {
+    struct NvapiOutputMode {
+        uint32_t width;
+        uint32_t height;
+        uint32_t bitsPerPixel;
+        uint32_t refreshRate; // Hz, 0 if unknown
+        bool interlaced;
+    };
+
     class NvapiOutput {
 
     public:
-        explicit NvapiOutput(uintptr_t parent);
+        explicit NvapiOutput(u_short parent);
         ~NvapiOutput();
 
         void Initialize(Com<IDXGIOutput>& dxgiOutput);
-        [[nodiscard]] uintptr_t GetParent() const;
+        [[nodiscard]] u_short GetParent() const;
         [[nodiscard]] std::string GetDeviceName() const;
         [[nodiscard]] bool IsPrimary() const;
+        [[nodiscard]] const RECT& GetDesktopCoordinates() const;
+        [[nodiscard]] DXGI_MODE_ROTATION GetRotation() const;
+        [[nodiscard]] const NvapiOutputMode& GetCurrentMode() const;
+        [[nodiscard]] const NV_HDR_CAPABILITIES_V2& GetHdrCapabilities() const;
+        [[nodiscard]] const std::vector<uint8_t>& GetEdid() const;
+        [[nodiscard]] const NvapiEdidInfo& GetEdidInfo() const;
+        [[nodiscard]] bool IsVrrCapable() const;
+        [[nodiscard]] bool IsEquivalent(const NvapiOutput& other) const;
+        [[nodiscard]] bool IsCurrent(Com<IDXGIOutput>& dxgiOutput) const;
 
     private:
-        uintptr_t m_parent;
+        void initializeMode(Com<IDXGIOutput>& dxgiOutput, DXGI_OUTPUT_DESC& desc);
+        [[nodiscard]] bool isSameMode(const NvapiOutput& other) const;
+        void initializeHdrCapabilities(Com<IDXGIOutput>& dxgiOutput);
+
+        u_short m_parent;
         std::string m_deviceName;
         bool m_isPrimary{};
+        HMONITOR m_monitor{};
+        RECT m_desktopCoordinates{};
+        DXGI_MODE_ROTATION m_rotation{};
+        NvapiOutputMode m_currentMode{};
+        DXGI_COLOR_SPACE_TYPE m_colorSpace{};
+        std::vector<uint8_t> m_edid;
+        NvapiEdidInfo m_edidInfo{};
+        NV_HDR_CAPABILITIES_V2 m_hdrCapabilities{};
+        bool m_isVrrCapable{};
     };
 }
@@ -0,0 +1,56 @@
+#include "nvapi_telemetry.h"
+
+#include <chrono>
+
+namespace dxvk {
+    // Utilization is reported by the driver over the last second anyway
+    constexpr auto sampleInterval = std::chrono::milliseconds(250);
+
+    NvapiTelemetry::NvapiTelemetry(ProviderFactory createProvider) {
+        // Titles may call FreeLibrary without NvAPI_Unload, and joining from DLL_PROCESS_DETACH would deadlock
+        // on the loader lock. Keep this module, found by any address inside it, loaded while the sampler thread runs.
+        if (!::GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, reinterpret_cast<LPCWSTR>(&sampleInterval), &m_module))
+            m_module = nullptr;
+
+        m_thread = std::thread([this, createProvider = std::move(createProvider)] { sampleLoop(createProvider); });
+    }
+
+    NvapiTelemetry::~NvapiTelemetry() {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stopped = true;
+        }
+
+        m_condition.notify_one();
+        m_thread.join();
+
+        // Only reached through NvAPI_Unload, the title still holds its own reference
+        if (m_module != nullptr)
+            ::FreeLibrary(m_module);
+    }
+
+    NvapiTelemetrySample NvapiTelemetry::GetSample() const {
+        return m_sample.Load();
+    }
+
+    void NvapiTelemetry::sampleLoop(const ProviderFactory& createProvider) {
+        m_provider = createProvider();
+        if (m_provider == nullptr)
+            return;
+
+        std::unique_lock lock(m_mutex);
+        do {
+            lock.unlock();
+            sample();
+            lock.lock();
+        } while (!m_condition.wait_for(lock, sampleInterval, [this] { return m_stopped; }));
+    }
+
+    void NvapiTelemetry::sample() {
+        NvapiTelemetrySample sample{};
+        if (!m_provider->Sample(sample))
+            sample = NvapiTelemetrySample{};
+
+        m_sample.Store(sample);
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../nvapi_private.h"
+#include "../util/util_seqlock.h"
+
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace dxvk {
+    enum class NvapiTelemetryField : uint32_t {
+        Utilization    = 1 << 0,
+        BusUtilization = 1 << 1,
+        Pstate         = 1 << 2,
+        Clocks         = 1 << 3,
+        BaseClocks     = 1 << 4,
+        BoostClocks    = 1 << 5,
+        Temperature    = 1 << 6,
+        PerfDecrease   = 1 << 7,
+    };
+
+    /**
+     * \brief Point in time GPU state
+     *
+     * Utilization in percent, clocks in kHz and temperatures in
+     * degree Celsius, performance decrease reasons as NVAPI_GPU_PERF_DECREASE
+     * flags. Only fields flagged as present are valid.
+     */
+    struct NvapiTelemetrySample {
+        uint32_t fields;
+        uint32_t gpuUtilization;
+        uint32_t memoryUtilization;
+        uint32_t videoUtilization;
+        uint32_t busUtilization;
+        uint32_t pstate;
+        uint32_t graphicsClock;
+        uint32_t memoryClock;
+        uint32_t videoClock;
+        uint32_t baseGraphicsClock;
+        uint32_t baseMemoryClock;
+        uint32_t boostGraphicsClock;
+        uint32_t boostMemoryClock;
+        int32_t gpuTemperature;
+        int32_t gpuMaxTemperature;
+        uint32_t perfDecreaseReasons;
+
+        [[nodiscard]] bool Has(NvapiTelemetryField field) const {
+            return fields & static_cast<uint32_t>(field);
+        }
+
+        void Set(NvapiTelemetryField field) {
+            fields |= static_cast<uint32_t>(field);
+        }
+    };
+
+    class NvapiTelemetryProvider {
+
+    public:
+        virtual ~NvapiTelemetryProvider() = default;
+
+        // Called from the sampling thread only
+        virtual bool Sample(NvapiTelemetrySample& sample) = 0;
+    };
+
+    /**
+     * \brief Background GPU telemetry sampler
+     *
+     * Creates its provider and takes every sample on its own
+     * thread, starting it never blocks. Readers only copy the
+     * latest sample and never block, the sample is empty until
+     * the first one was published or without a provider. The
+     * module stays loaded until the sampler is destroyed.
+     */
+    class NvapiTelemetry {
+
+    public:
+        using ProviderFactory = std::function<std::unique_ptr<NvapiTelemetryProvider>()>;
+
+        explicit NvapiTelemetry(ProviderFactory createProvider);
+        ~NvapiTelemetry();
+
+        [[nodiscard]] NvapiTelemetrySample GetSample() const;
+
+    private:
+        void sampleLoop(const ProviderFactory& createProvider);
+        void sample();
+
+        std::unique_ptr<NvapiTelemetryProvider> m_provider;
+        SeqLock<NvapiTelemetrySample> m_sample;
+
+        HMODULE m_module{};
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopped{};
+    };
+}
@@ -0,0 +1,156 @@
+#include "nvapi_telemetry_providers.h"
+#include "../util/util_string.h"
+#include "../util/util_log.h"
+
+namespace dxvk {
+    constexpr uint32_t kHzPerMHz = 1000;
+
+    uint32_t toPerfDecreaseReasons(unsigned long long throttleReasons) {
+        uint32_t reasons = NV_GPU_PERF_DECREASE_NONE;
+        if (throttleReasons & (nvmlClocksThrottleReasonSwThermalSlowdown | nvmlClocksThrottleReasonHwThermalSlowdown))
+            reasons |= NV_GPU_PERF_DECREASE_REASON_THERMAL_PROTECTION;
+
+        // The power brake is asserted externally, e.g. by the power supply, insufficient power means a missing power connector
+        if (throttleReasons & (nvmlClocksThrottleReasonSwPowerCap | nvmlClocksThrottleReasonHwPowerBrakeSlowdown))
+            reasons |= NV_GPU_PERF_DECREASE_REASON_POWER_CONTROL;
+
+        if (throttleReasons & nvmlClocksThrottleReasonApplicationsClocksSetting)
+            reasons |= NV_GPU_PERF_DECREASE_REASON_API_TRIGGERED;
+
+        // Hardware slowdown without any of its known causes
+        if ((throttleReasons & nvmlClocksThrottleReasonHwSlowdown) && reasons == NV_GPU_PERF_DECREASE_NONE)
+            reasons |= NV_GPU_PERF_DECREASE_REASON_UNKNOWN;
+
+        // Idle, sync boost and display clock limits are no performance decrease
+        return reasons;
+    }
+
+    NvapiNvmlTelemetryProvider::NvapiNvmlTelemetryProvider(std::shared_ptr<NvapiNvml> nvml, std::string pciBusId)
+        : m_nvml(std::move(nvml)), m_pciBusId(std::move(pciBusId)) {}
+
+    bool NvapiNvmlTelemetryProvider::Sample(NvapiTelemetrySample& sample) {
+        if (m_device == nullptr && m_nvml->nvmlDeviceGetHandleByPciBusId_v2(m_pciBusId.c_str(), &m_device) != NVML_SUCCESS) {
+            m_device = nullptr;
+            return false;
+        }
+
+        nvmlUtilization_t utilization;
+        unsigned int encoderUtilization, decoderUtilization, samplingPeriod;
+        if (m_nvml->nvmlDeviceGetUtilizationRates(m_device, &utilization) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetEncoderUtilization(m_device, &encoderUtilization, &samplingPeriod) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetDecoderUtilization(m_device, &decoderUtilization, &samplingPeriod) == NVML_SUCCESS) {
+            sample.gpuUtilization = utilization.gpu;
+            sample.memoryUtilization = utilization.memory;
+            sample.videoUtilization = std::max(encoderUtilization, decoderUtilization);
+            sample.Set(NvapiTelemetryField::Utilization);
+        }
+
+        nvmlPstates_t pstate;
+        if (m_nvml->nvmlDeviceGetPerformanceState(m_device, &pstate) == NVML_SUCCESS && pstate != NVML_PSTATE_UNKNOWN) {
+            sample.pstate = static_cast<uint32_t>(pstate);
+            sample.Set(NvapiTelemetryField::Pstate);
+        }
+
+        unsigned int graphicsClock, memoryClock, videoClock;
+        if (m_nvml->nvmlDeviceGetClockInfo(m_device, NVML_CLOCK_GRAPHICS, &graphicsClock) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetClockInfo(m_device, NVML_CLOCK_MEM, &memoryClock) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetClockInfo(m_device, NVML_CLOCK_VIDEO, &videoClock) == NVML_SUCCESS) {
+            sample.graphicsClock = graphicsClock * kHzPerMHz;
+            sample.memoryClock = memoryClock * kHzPerMHz;
+            sample.videoClock = videoClock * kHzPerMHz;
+            sample.Set(NvapiTelemetryField::Clocks);
+        }
+
+        if (m_nvml->nvmlDeviceGetDefaultApplicationsClock(m_device, NVML_CLOCK_GRAPHICS, &graphicsClock) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetDefaultApplicationsClock(m_device, NVML_CLOCK_MEM, &memoryClock) == NVML_SUCCESS) {
+            sample.baseGraphicsClock = graphicsClock * kHzPerMHz;
+            sample.baseMemoryClock = memoryClock * kHzPerMHz;
+            sample.Set(NvapiTelemetryField::BaseClocks);
+        }
+
+        if (m_nvml->nvmlDeviceGetMaxClockInfo(m_device, NVML_CLOCK_GRAPHICS, &graphicsClock) == NVML_SUCCESS
+            && m_nvml->nvmlDeviceGetMaxClockInfo(m_device, NVML_CLOCK_MEM, &memoryClock) == NVML_SUCCESS) {
+            sample.boostGraphicsClock = graphicsClock * kHzPerMHz;
+            sample.boostMemoryClock = memoryClock * kHzPerMHz;
+            sample.Set(NvapiTelemetryField::BoostClocks);
+        }
+
+        unsigned int temperature, maxTemperature;
+        if (m_nvml->nvmlDeviceGetTemperature(m_device, NVML_TEMPERATURE_GPU, &temperature) == NVML_SUCCESS) {
+            if (m_nvml->nvmlDeviceGetTemperatureThreshold(m_device, NVML_TEMPERATURE_THRESHOLD_SLOWDOWN, &maxTemperature) != NVML_SUCCESS)
+                maxTemperature = 0;
+
+            sample.gpuTemperature = static_cast<int32_t>(temperature);
+            sample.gpuMaxTemperature = static_cast<int32_t>(maxTemperature);
+            sample.Set(NvapiTelemetryField::Temperature);
+        }
+
+        unsigned long long throttleReasons;
+        if (m_nvml->nvmlDeviceGetCurrentClocksThrottleReasons != nullptr
+            && m_nvml->nvmlDeviceGetCurrentClocksThrottleReasons(m_device, &throttleReasons) == NVML_SUCCESS) {
+            sample.perfDecreaseReasons = toPerfDecreaseReasons(throttleReasons);
+            sample.Set(NvapiTelemetryField::PerfDecrease);
+        }
+
+        return sample.fields != 0;
+    }
+
+    NvapiFileTelemetryProvider::NvapiFileTelemetryProvider(std::string path)
+        : m_path(std::move(path)) {}
+
+    bool NvapiFileTelemetryProvider::Sample(NvapiTelemetrySample& sample) {
+        std::ifstream stream(m_path);
+        if (!stream)
+            return false;
+
+        struct Key {
+            const char* name;
+            NvapiTelemetryField field;
+            uint32_t NvapiTelemetrySample::*value;
+        };
+
+        static const Key keys[] = {
+            {"gpu_utilization", NvapiTelemetryField::Utilization, &NvapiTelemetrySample::gpuUtilization},
+            {"memory_utilization", NvapiTelemetryField::Utilization, &NvapiTelemetrySample::memoryUtilization},
+            {"video_utilization", NvapiTelemetryField::Utilization, &NvapiTelemetrySample::videoUtilization},
+            {"bus_utilization", NvapiTelemetryField::BusUtilization, &NvapiTelemetrySample::busUtilization},
+            {"pstate", NvapiTelemetryField::Pstate, &NvapiTelemetrySample::pstate},
+            {"graphics_clock", NvapiTelemetryField::Clocks, &NvapiTelemetrySample::graphicsClock},
+            {"memory_clock", NvapiTelemetryField::Clocks, &NvapiTelemetrySample::memoryClock},
+            {"video_clock", NvapiTelemetryField::Clocks, &NvapiTelemetrySample::videoClock},
+            {"base_graphics_clock", NvapiTelemetryField::BaseClocks, &NvapiTelemetrySample::baseGraphicsClock},
+            {"base_memory_clock", NvapiTelemetryField::BaseClocks, &NvapiTelemetrySample::baseMemoryClock},
+            {"boost_graphics_clock", NvapiTelemetryField::BoostClocks, &NvapiTelemetrySample::boostGraphicsClock},
+            {"boost_memory_clock", NvapiTelemetryField::BoostClocks, &NvapiTelemetrySample::boostMemoryClock},
+            {"perf_decrease", NvapiTelemetryField::PerfDecrease, &NvapiTelemetrySample::perfDecreaseReasons},
+        };
+
+        std::string line;
+        while (std::getline(stream, line)) {
+            auto separator = line.find('=');
+            if (separator == std::string::npos)
+                continue;
+
+            auto name = line.substr(0, separator);
+            // Flags are usually written in hex, everything else is decimal and may have leading zeros
+            auto value = std::strtoll(line.c_str() + separator + 1, nullptr, name == "perf_decrease" ? 0 : 10);
+
+            if (name == "gpu_temperature" || name == "gpu_max_temperature") {
+                (name == "gpu_temperature" ? sample.gpuTemperature : sample.gpuMaxTemperature) = static_cast<int32_t>(value);
+                sample.Set(NvapiTelemetryField::Temperature);
+                continue;
+            }
+
+            for (const auto& key : keys) {
+                if (name != key.name)
+                    continue;
+
+                sample.*key.value = static_cast<uint32_t>(value);
+                sample.Set(key.field);
+                break;
+            }
+        }
+
+        return sample.fields != 0;
+    }
+}
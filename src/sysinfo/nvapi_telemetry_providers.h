@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../nvapi_private.h"
+#include "nvapi_telemetry.h"
+#include "nvapi_nvml.h"
+
+namespace dxvk {
+    /**
+     * \brief Telemetry from NVML
+     *
+     * The NVML device is looked up by PCI bus ID, which is the only
+     * identifier both Vulkan and NVML agree on.
+     */
+    class NvapiNvmlTelemetryProvider : public NvapiTelemetryProvider {
+
+    public:
+        NvapiNvmlTelemetryProvider(std::shared_ptr<NvapiNvml> nvml, std::string pciBusId);
+
+        bool Sample(NvapiTelemetrySample& sample) override;
+
+    private:
+        std::shared_ptr<NvapiNvml> m_nvml;
+        std::string m_pciBusId;
+        nvmlDevice_t m_device{};
+    };
+
+    /**
+     * \brief Telemetry from a plain text file
+     *
+     * Stand-in for systems without NVML. The file is read again on
+     * every sample and contains key=value lines in NvAPI units.
+     */
+    class NvapiFileTelemetryProvider : public NvapiTelemetryProvider {
+
+    public:
+        explicit NvapiFileTelemetryProvider(std::string path);
+
+        bool Sample(NvapiTelemetrySample& sample) override;
+
+    private:
+        std::string m_path;
+    };
+}
@@ -0,0 +1,413 @@
+#include "nvapi_topology.h"
+#include "../util/util_string.h"
+#include "../util/util_env.h"
+#include "../util/util_log.h"
+
+#include <cstdio>
+
+namespace dxvk {
+    constexpr auto mosaicEnvName = "DXVK_NVAPI_MOSAIC";
+
+    struct MosaicConfig {
+        NV_MOSAIC_TOPO topo = NV_MOSAIC_TOPO_NONE;
+        uint32_t rows{};
+        uint32_t columns{};
+        int32_t overlapX{};
+        int32_t overlapY{};
+        std::vector<std::string> displays; // GDI device names, all outputs of the primary adapter when empty
+    };
+
+    constexpr uint32_t toDisplayId(const u_short parent, const uint32_t connector) {
+        return NvapiTopology::displayIdBase | (static_cast<uint32_t>(parent) << 8) | connector;
+    }
+
+    // Only the basic topologies have a name NvAPI can report
+    static NV_MOSAIC_TOPO toMosaicTopo(const uint32_t rows, const uint32_t columns) {
+        static constexpr struct {
+            uint32_t rows;
+            uint32_t columns;
+            NV_MOSAIC_TOPO topo;
+        } topos[] = {
+            {1, 2, NV_MOSAIC_TOPO_1x2_BASIC},
+            {2, 1, NV_MOSAIC_TOPO_2x1_BASIC},
+            {1, 3, NV_MOSAIC_TOPO_1x3_BASIC},
+            {3, 1, NV_MOSAIC_TOPO_3x1_BASIC},
+            {1, 4, NV_MOSAIC_TOPO_1x4_BASIC},
+            {4, 1, NV_MOSAIC_TOPO_4x1_BASIC},
+            {2, 2, NV_MOSAIC_TOPO_2x2_BASIC},
+            {2, 3, NV_MOSAIC_TOPO_2x3_BASIC},
+            {2, 4, NV_MOSAIC_TOPO_2x4_BASIC},
+            {3, 2, NV_MOSAIC_TOPO_3x2_BASIC},
+            {4, 2, NV_MOSAIC_TOPO_4x2_BASIC},
+            {1, 5, NV_MOSAIC_TOPO_1x5_BASIC},
+            {1, 6, NV_MOSAIC_TOPO_1x6_BASIC},
+            {7, 1, NV_MOSAIC_TOPO_7x1_BASIC},
+        };
+
+        for (const auto& topo : topos) {
+            if (topo.rows == rows && topo.columns == columns)
+                return topo.topo;
+        }
+
+        return NV_MOSAIC_TOPO_NONE;
+    }
+
+    // Read once, snapshots are rebuilt whenever the displays change
+    static const MosaicConfig& getMosaicConfig() {
+        static const auto config = [] {
+            MosaicConfig config;
+            env::forEachOverride(mosaicEnvName, [&config](const std::string& name, const std::string& value) {
+                char trailing;
+                if (name == "grid") {
+                    uint32_t rows, columns;
+                    if (std::sscanf(value.c_str(), "%ux%u%c", &rows, &columns, &trailing) != 2)
+                        return false;
+
+                    config.topo = toMosaicTopo(rows, columns);
+                    config.rows = rows;
+                    config.columns = columns;
+                    return config.topo != NV_MOSAIC_TOPO_NONE;
+                }
+
+                if (name == "overlap")
+                    return std::sscanf(value.c_str(), "%dx%d%c", &config.overlapX, &config.overlapY, &trailing) == 2;
+
+                if (name == "displays") {
+                    std::stringstream stream(value);
+                    std::string number;
+                    while (std::getline(stream, number, ';'))
+                        config.displays.push_back(str::format("\\\\.\\DISPLAY", number));
+
+                    return !config.displays.empty();
+                }
+
+                return false;
+            });
+
+            return config;
+        }();
+
+        return config;
+    }
+
+    static NV_GPU_OUTPUT_TYPE toOutputType(const NvapiOutput& output) {
+        // DXGI does not know the connector, the EDID video input definition at least tells digital from analog
+        const auto& edidInfo = output.GetEdidInfo();
+        if (edidInfo.isDigital)
+            return NVAPI_GPU_OUTPUT_DFP;
+
+        if (edidInfo.connectorType == NV_MONITOR_CONN_TYPE_VGA)
+            return NVAPI_GPU_OUTPUT_CRT;
+
+        return NVAPI_GPU_OUTPUT_UNKNOWN;
+    }
+
+    static NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1 toSourceModeInfo(const NvapiOutput& output) {
+        const auto& mode = output.GetCurrentMode();
+        const auto& coordinates = output.GetDesktopCoordinates();
+
+        NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1 sourceModeInfo{};
+        sourceModeInfo.resolution.width = mode.width;
+        sourceModeInfo.resolution.height = mode.height;
+        sourceModeInfo.resolution.colorDepth = mode.bitsPerPixel;
+        sourceModeInfo.colorFormat = NV_FORMAT_UNKNOWN;
+        sourceModeInfo.position.x = coordinates.left;
+        sourceModeInfo.position.y = coordinates.top;
+        sourceModeInfo.spanningOrientation = NV_DISPLAYCONFIG_SPAN_NONE;
+        sourceModeInfo.bGDIPrimary = output.IsPrimary();
+        return sourceModeInfo;
+    }
+
+    static NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1 toTargetInfo(const NvapiOutput& output) {
+        const auto& mode = output.GetCurrentMode();
+
+        NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1 targetInfo{};
+        targetInfo.version = NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_VER1;
+        switch (output.GetRotation()) {
+            case DXGI_MODE_ROTATION_ROTATE90:
+                targetInfo.rotation = NV_ROTATE_90;
+                break;
+            case DXGI_MODE_ROTATION_ROTATE180:
+                targetInfo.rotation = NV_ROTATE_180;
+                break;
+            case DXGI_MODE_ROTATION_ROTATE270:
+                targetInfo.rotation = NV_ROTATE_270;
+                break;
+            default:
+                targetInfo.rotation = NV_ROTATE_0;
+                break;
+        }
+
+        targetInfo.scaling = NV_SCALING_DEFAULT;
+        targetInfo.refreshRate1K = mode.refreshRate * 1000;
+        targetInfo.interlaced = mode.interlaced;
+        targetInfo.primary = true;
+        targetInfo.tvFormat = NV_DISPLAY_TV_FORMAT_NONE;
+        targetInfo.timingOverride = NV_TIMING_OVERRIDE_CURRENT;
+        return targetInfo;
+    }
+
+    NvapiTopology::NvapiTopology() = default;
+
+    NvapiTopology::~NvapiTopology() = default;
+
+    void NvapiTopology::Initialize(std::vector<std::shared_ptr<NvapiOutput>> outputs, const NvapiTopology* previous) {
+        // Outputs that are still connected keep their connector, unchanged ones also keep their object
+        std::vector<int32_t> connectors(outputs.size(), -1);
+        std::vector<uint32_t> usedConnectors;
+        for (auto i = 0U; i < outputs.size(); i++) {
+            auto& output = outputs[i];
+            auto parent = output->GetParent();
+            if (usedConnectors.size() <= parent)
+                usedConnectors.resize(parent + 1);
+
+            auto previousIndex = previous != nullptr ? previous->findOutput(parent, output->GetDeviceName()) : -1;
+            if (previousIndex == -1)
+                continue;
+
+            if (previous->m_outputs[previousIndex]->IsEquivalent(*output))
+                output = previous->m_outputs[previousIndex];
+            else
+                log::write(str::format("NvAPI Output: ", output->GetDeviceName(), " changed"));
+
+            connectors[i] = previous->m_outputConnectors[previousIndex];
+            usedConnectors[parent] |= 1U << connectors[i];
+        }
+
+        // New outputs take the lowest free connector of their adapter
+        for (auto i = 0U; i < outputs.size(); i++) {
+            if (connectors[i] != -1)
+                continue;
+
+            auto parent = outputs[i]->GetParent();
+            auto connector = 0U;
+            while (connector < maxConnectors && (usedConnectors[parent] & (1U << connector)))
+                connector++;
+
+            if (connector == maxConnectors) {
+                log::write(str::format("NvAPI Output: ", outputs[i]->GetDeviceName(), " ignored, no free connector"));
+                continue;
+            }
+
+            connectors[i] = connector;
+            usedConnectors[parent] |= 1U << connector;
+            log::write(str::format("NvAPI Output: ", outputs[i]->GetDeviceName(), " (display ID 0x", std::hex, toDisplayId(parent, connector), ")"));
+        }
+
+        m_outputs.reserve(outputs.size());
+        m_outputParents.reserve(outputs.size());
+        m_outputConnectors.reserve(outputs.size());
+        m_outputTypes.reserve(outputs.size());
+        m_sourceModeInfos.reserve(outputs.size());
+        m_targetInfos.reserve(outputs.size());
+        m_outputNameOffsets.reserve(outputs.size() + 1);
+        m_outputsMasks.resize(usedConnectors.size());
+        m_outputIndexByConnector.resize(usedConnectors.size() * maxConnectors, -1);
+
+        for (auto i = 0U; i < outputs.size(); i++) {
+            if (connectors[i] == -1)
+                continue;
+
+            auto index = static_cast<short>(m_outputs.size());
+            const auto& output = m_outputs.emplace_back(std::move(outputs[i]));
+            m_outputParents.push_back(output->GetParent());
+            m_outputConnectors.push_back(connectors[i]);
+            m_outputTypes.push_back(toOutputType(*output));
+            m_outputsMasks[output->GetParent()] |= 1U << connectors[i];
+            m_sourceModeInfos.push_back(toSourceModeInfo(*output));
+            m_targetInfos.push_back(toTargetInfo(*output));
+            m_outputNameOffsets.push_back(m_outputNames.size());
+            m_outputNames += output->GetDeviceName();
+            m_outputIndexByConnector[output->GetParent() * maxConnectors + connectors[i]] = index;
+
+            if (m_primaryOutputId == 0 && output->IsPrimary())
+                m_primaryOutputId = GetOutputId(index);
+        }
+
+        m_outputNameOffsets.push_back(m_outputNames.size());
+
+        // Lookups by name are done per frame by some titles, index them once the arena is complete
+        m_outputIndexByName.reserve(m_outputs.size());
+        for (auto i = 0U; i < m_outputs.size(); i++)
+            m_outputIndexByName.emplace(GetOutputName(i), i);
+
+        NvapiDisplayGrid mosaicGrid{};
+        m_hasMosaicGrid = buildMosaicGrid(mosaicGrid);
+
+        // Snapshots are rebuilt whenever the display setup might have changed, only log what actually did
+        if (!m_mosaicStatus.empty() && (previous == nullptr || previous->m_mosaicStatus != m_mosaicStatus))
+            log::write(m_mosaicStatus);
+
+        if (m_hasMosaicGrid)
+            m_displayGrids.push_back(std::move(mosaicGrid));
+
+        for (auto i = 0U; i < m_outputs.size(); i++) {
+            if (m_hasMosaicGrid && std::find(m_displayGrids[0].outputs.begin(), m_displayGrids[0].outputs.end(), i) != m_displayGrids[0].outputs.end())
+                continue;
+
+            m_displayGrids.push_back({NV_MOSAIC_TOPO_NONE, 1, 1, 0, 0, {static_cast<u_short>(i)}});
+        }
+    }
+
+    bool NvapiTopology::IsEquivalent(const NvapiTopology& other) const {
+        return m_outputs == other.m_outputs && m_outputConnectors == other.m_outputConnectors;
+    }
+
+    u_short NvapiTopology::GetOutputCount() const {
+        return m_outputs.size();
+    }
+
+    NvapiOutput* NvapiTopology::GetOutput(const u_short index) const {
+        return index < m_outputs.size() ? m_outputs[index].get() : nullptr;
+    }
+
+    NvapiOutput* NvapiTopology::GetOutputById(const uint32_t displayId) const {
+        auto index = GetOutputIndex(displayId);
+        return index != -1 ? m_outputs[index].get() : nullptr;
+    }
+
+    short NvapiTopology::GetOutputIndex(const uint32_t displayId) const {
+        if ((displayId & ~0xffffU) != displayIdBase)
+            return -1;
+
+        return findOutput(static_cast<u_short>((displayId >> 8) & 0xff), displayId & 0xff);
+    }
+
+    uint32_t NvapiTopology::GetOutputId(const u_short index) const {
+        return toDisplayId(m_outputParents[index], m_outputConnectors[index]);
+    }
+
+    uint32_t NvapiTopology::GetOutputMask(const u_short index) const {
+        return 1U << m_outputConnectors[index];
+    }
+
+    NV_GPU_OUTPUT_TYPE NvapiTopology::GetOutputType(const u_short index) const {
+        return m_outputTypes[index];
+    }
+
+    u_short NvapiTopology::GetOutputParent(const u_short index) const {
+        return m_outputParents[index];
+    }
+
+    std::string_view NvapiTopology::GetOutputName(const u_short index) const {
+        return std::string_view(m_outputNames).substr(m_outputNameOffsets[index], m_outputNameOffsets[index + 1] - m_outputNameOffsets[index]);
+    }
+
+    uint32_t NvapiTopology::GetPrimaryOutputId() const {
+        return m_primaryOutputId;
+    }
+
+    uint32_t NvapiTopology::GetOutputId(const std::string_view displayName) const {
+        auto it = m_outputIndexByName.find(displayName);
+        return it != m_outputIndexByName.end() ? GetOutputId(it->second) : 0;
+    }
+
+    uint32_t NvapiTopology::GetOutputId(const u_short parent, const uint32_t outputMask) const {
+        // Output IDs have exactly one bit set
+        if (outputMask == 0 || (outputMask & (outputMask - 1)) != 0)
+            return 0;
+
+        auto connector = 0U;
+        while (!(outputMask & (1U << connector)))
+            connector++;
+
+        auto index = findOutput(parent, connector);
+        return index != -1 ? GetOutputId(index) : 0;
+    }
+
+    uint32_t NvapiTopology::GetOutputsMask(const u_short parent) const {
+        return parent < m_outputsMasks.size() ? m_outputsMasks[parent] : 0;
+    }
+
+    const NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1& NvapiTopology::GetSourceModeInfo(const u_short index) const {
+        return m_sourceModeInfos[index];
+    }
+
+    const NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1& NvapiTopology::GetTargetInfo(const u_short index) const {
+        return m_targetInfos[index];
+    }
+
+    const std::vector<NvapiDisplayGrid>& NvapiTopology::GetDisplayGrids() const {
+        return m_displayGrids;
+    }
+
+    const NvapiDisplayGrid* NvapiTopology::GetMosaicGrid() const {
+        return m_hasMosaicGrid ? &m_displayGrids[0] : nullptr;
+    }
+
+    short NvapiTopology::findOutput(const u_short parent, const std::string_view displayName) const {
+        auto it = m_outputIndexByName.find(displayName);
+        return it != m_outputIndexByName.end() && m_outputParents[it->second] == parent ? static_cast<short>(it->second) : -1;
+    }
+
+    short NvapiTopology::findOutput(const u_short parent, const uint32_t connector) const {
+        auto slot = static_cast<size_t>(parent) * maxConnectors + connector;
+        return connector < maxConnectors && slot < m_outputIndexByConnector.size() ? m_outputIndexByConnector[slot] : -1;
+    }
+
+    bool NvapiTopology::buildMosaicGrid(NvapiDisplayGrid& grid) {
+        const auto& config = getMosaicConfig();
+        if (config.topo == NV_MOSAIC_TOPO_NONE)
+            return false;
+
+        auto reject = [this, &config](const std::string& reason) {
+            m_mosaicStatus = str::format("NvAPI Mosaic: ", config.rows, "x", config.columns, " grid ignored, ", reason);
+            return false;
+        };
+
+        std::vector<u_short> outputs;
+        if (!config.displays.empty()) {
+            for (const auto& displayName : config.displays) {
+                auto it = m_outputIndexByName.find(displayName);
+                if (it == m_outputIndexByName.end())
+                    return reject(str::format(displayName, " not found"));
+
+                outputs.push_back(it->second);
+            }
+        } else {
+            auto primary = GetOutputIndex(m_primaryOutputId);
+            auto parent = primary != -1 ? m_outputParents[primary] : 0;
+            for (auto i = 0U; i < m_outputs.size(); i++) {
+                if (m_outputParents[i] == parent)
+                    outputs.push_back(i);
+            }
+        }
+
+        if (outputs.size() != config.rows * config.columns)
+            return reject(str::format(outputs.size(), " displays available"));
+
+        // Tiles are assigned in desktop order, which then has to match the grid exactly
+        std::sort(outputs.begin(), outputs.end(), [this](const u_short a, const u_short b) {
+            const auto& left = m_outputs[a]->GetDesktopCoordinates();
+            const auto& right = m_outputs[b]->GetDesktopCoordinates();
+            return std::tie(left.top, left.left) < std::tie(right.top, right.left);
+        });
+
+        const auto& first = *m_outputs[outputs[0]];
+        const auto& origin = first.GetDesktopCoordinates();
+        auto width = origin.right - origin.left;
+        auto height = origin.bottom - origin.top;
+        if (config.overlapX >= width || config.overlapY >= height)
+            return reject("overlap exceeds the display size");
+
+        for (auto i = 0U; i < outputs.size(); i++) {
+            const auto& output = *m_outputs[outputs[i]];
+            if (output.GetParent() != first.GetParent())
+                return reject("displays are driven by different adapters");
+
+            const auto& mode = output.GetCurrentMode();
+            if (mode.refreshRate != first.GetCurrentMode().refreshRate || mode.bitsPerPixel != first.GetCurrentMode().bitsPerPixel || output.GetRotation() != first.GetRotation())
+                return reject("display modes differ");
+
+            const auto& coordinates = output.GetDesktopCoordinates();
+            auto left = origin.left + static_cast<LONG>(i % config.columns) * width;
+            auto top = origin.top + static_cast<LONG>(i / config.columns) * height;
+            if (coordinates.left != left || coordinates.top != top || coordinates.right != left + width || coordinates.bottom != top + height)
+                return reject(str::format(output.GetDeviceName(), " does not fit the grid"));
+        }
+
+        grid = {config.topo, config.rows, config.columns, config.overlapX, config.overlapY, std::move(outputs)};
+        m_mosaicStatus = str::format("NvAPI Mosaic: ", config.rows, "x", config.columns, " grid of ", width, "x", height, " displays, overlap ", config.overlapX, "x", config.overlapY);
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../nvapi_private.h"
+#include "nvapi_output.h"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace dxvk {
+    /**
+     * \brief Display grid
+     *
+     * Either the emulated Mosaic grid or a single display
+     * that is not part of it.
+     */
+    struct NvapiDisplayGrid {
+        NV_MOSAIC_TOPO topo;          // NV_MOSAIC_TOPO_NONE for single displays
+        uint32_t rows;
+        uint32_t columns;
+        int32_t overlapX;             // Pixels, positive for overlap, negative for a gap
+        int32_t overlapY;
+        std::vector<u_short> outputs; // Output indices, [row * columns + column]
+    };
+
+    /**
+     * \brief Immutable snapshot of all outputs
+     *
+     * Built once and published as a whole, per output data
+     * is kept in parallel arrays and all device names share
+     * one string arena. Outputs are shared between snapshots
+     * when they did not change.
+     */
+    class NvapiTopology {
+
+    public:
+        // Display IDs are 0x80000000 | adapter index << 8 | connector, the output ID of a display is its connector bit
+        static constexpr uint32_t displayIdBase = 0x80000000;
+        static constexpr uint32_t maxConnectors = 32;
+
+        NvapiTopology();
+        ~NvapiTopology();
+
+        // Takes over unchanged outputs and connectors from the previous snapshot, if any
+        void Initialize(std::vector<std::shared_ptr<NvapiOutput>> outputs, const NvapiTopology* previous);
+        [[nodiscard]] bool IsEquivalent(const NvapiTopology& other) const;
+
+        [[nodiscard]] u_short GetOutputCount() const;
+        [[nodiscard]] NvapiOutput* GetOutput(u_short index) const;
+        [[nodiscard]] NvapiOutput* GetOutputById(uint32_t displayId) const;
+        [[nodiscard]] short GetOutputIndex(uint32_t displayId) const;
+        [[nodiscard]] uint32_t GetOutputId(u_short index) const;
+        [[nodiscard]] uint32_t GetOutputMask(u_short index) const;
+        [[nodiscard]] NV_GPU_OUTPUT_TYPE GetOutputType(u_short index) const;
+        [[nodiscard]] u_short GetOutputParent(u_short index) const;
+        [[nodiscard]] std::string_view GetOutputName(u_short index) const;
+        [[nodiscard]] uint32_t GetPrimaryOutputId() const;
+        [[nodiscard]] uint32_t GetOutputId(std::string_view displayName) const;
+        [[nodiscard]] uint32_t GetOutputId(u_short parent, uint32_t outputMask) const;
+        [[nodiscard]] uint32_t GetOutputsMask(u_short parent) const;
+
+        // Display configuration, every output is the single target of its own path
+        [[nodiscard]] const NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1& GetSourceModeInfo(u_short index) const;
+        [[nodiscard]] const NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1& GetTargetInfo(u_short index) const;
+
+        // The configured Mosaic grid comes first when it matches the outputs, followed by one grid per remaining output
+        [[nodiscard]] const std::vector<NvapiDisplayGrid>& GetDisplayGrids() const;
+        [[nodiscard]] const NvapiDisplayGrid* GetMosaicGrid() const;
+
+    private:
+        [[nodiscard]] short findOutput(u_short parent, std::string_view displayName) const;
+        [[nodiscard]] short findOutput(u_short parent, uint32_t connector) const;
+        [[nodiscard]] bool buildMosaicGrid(NvapiDisplayGrid& grid);
+
+        // Indexed by enumeration order
+        std::vector<std::shared_ptr<NvapiOutput>> m_outputs;
+        std::vector<u_short> m_outputParents;
+        std::vector<uint8_t> m_outputConnectors;
+        std::vector<NV_GPU_OUTPUT_TYPE> m_outputTypes;
+        std::vector<NV_DISPLAYCONFIG_SOURCE_MODE_INFO_V1> m_sourceModeInfos;
+        std::vector<NV_DISPLAYCONFIG_PATH_ADVANCED_TARGET_INFO_V1> m_targetInfos;
+        std::vector<uint32_t> m_outputNameOffsets; // One more than outputs, name i spans [i, i + 1)
+        std::string m_outputNames;
+
+        // Indexed by adapter index, one bit per used connector
+        std::vector<uint32_t> m_outputsMasks;
+
+        // Indexed by adapter index * maxConnectors + connector, -1 for unused connectors
+        std::vector<short> m_outputIndexByConnector;
+
+        // Keys point into m_outputNames, which is not modified after building the index
+        std::unordered_map<std::string_view, u_short> m_outputIndexByName;
+        uint32_t m_primaryOutputId{};
+
+        std::vector<NvapiDisplayGrid> m_displayGrids;
+        bool m_hasMosaicGrid{};
+        std::string m_mosaicStatus; // Outcome of building the configured grid, empty without one
+    };
+}
@@ -0,0 +1,56 @@
+#include "nvapi_vulkan_dispatch.h"
+#include "../util/util_string.h"
+#include "../util/util_log.h"
+
+namespace dxvk {
+    NvapiVulkanDispatch::NvapiVulkanDispatch() = default;
+
+    NvapiVulkanDispatch::~NvapiVulkanDispatch() {
+        if (m_vkModule != nullptr)
+            FreeLibrary(m_vkModule);
+    }
+
+    bool NvapiVulkanDispatch::Load() {
+        const auto vkModuleName = "vulkan-1.dll";
+        m_vkModule = ::LoadLibraryA(vkModuleName);
+        if (m_vkModule == nullptr) {
+            log::write(str::format("Loading ", vkModuleName, " failed with error code ", ::GetLastError()));
+            return false;
+        }
+
+        // DXVK requires a Vulkan 1.1 capable loader, which exports all functions below
+        if (!resolve(vkGetInstanceProcAddr, "vkGetInstanceProcAddr")
+            || !resolve(vkEnumerateDeviceExtensionProperties, "vkEnumerateDeviceExtensionProperties")
+            || !resolve(vkEnumeratePhysicalDeviceGroups, "vkEnumeratePhysicalDeviceGroups")
+            || !resolve(vkGetPhysicalDeviceProperties2, "vkGetPhysicalDeviceProperties2")
+            || !resolve(vkGetPhysicalDeviceMemoryProperties2, "vkGetPhysicalDeviceMemoryProperties2"))
+            return false;
+
+        // Global command that is not available on Vulkan 1.0 loaders, query it the way the specification asks for
+        vkEnumerateInstanceVersion =
+            reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+                vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion"));
+
+        m_loaderVersion = VK_API_VERSION_1_0;
+        if (vkEnumerateInstanceVersion != nullptr)
+            vkEnumerateInstanceVersion(&m_loaderVersion);
+
+        return true;
+    }
+
+    uint32_t NvapiVulkanDispatch::GetLoaderVersion() const {
+        return m_loaderVersion;
+    }
+
+    template<typename T>
+    bool NvapiVulkanDispatch::resolve(T& function, const char* name) {
+        function = reinterpret_cast<T>(
+            reinterpret_cast<void*>(
+                GetProcAddress(m_vkModule, name)));
+
+        if (function == nullptr)
+            log::write(str::format("Resolving ", name, " failed"));
+
+        return function != nullptr;
+    }
+}
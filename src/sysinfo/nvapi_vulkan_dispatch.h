@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <memory>
+
+namespace dxvk {
+    /**
+     * \brief Vulkan loader dispatch table
+     *
+     * Loads vulkan-1.dll once and resolves all entry points
+     * used by the adapters. Shared between the registry and
+     * its adapters, the loader is released with the last reference.
+     */
+    class NvapiVulkanDispatch {
+
+    public:
+        NvapiVulkanDispatch();
+        ~NvapiVulkanDispatch();
+
+        bool Load();
+        [[nodiscard]] uint32_t GetLoaderVersion() const;
+
+        PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr{};
+        PFN_vkEnumerateInstanceVersion vkEnumerateInstanceVersion{};
+        PFN_vkEnumerateDeviceExtensionProperties vkEnumerateDeviceExtensionProperties{};
+        PFN_vkEnumeratePhysicalDeviceGroups vkEnumeratePhysicalDeviceGroups{};
+        PFN_vkGetPhysicalDeviceProperties2 vkGetPhysicalDeviceProperties2{};
+        PFN_vkGetPhysicalDeviceMemoryProperties2 vkGetPhysicalDeviceMemoryProperties2{};
+
+    private:
+        HMODULE m_vkModule{};
+        uint32_t m_loaderVersion{};
+
+        template<typename T>
+        bool resolve(T& function, const char* name);
+    };
+}
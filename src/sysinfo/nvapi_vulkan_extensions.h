@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <bitset>
+#include <string_view>
+
+namespace dxvk {
+    /**
+     * \brief Vulkan device extensions we care about
+     *
+     * Only these are tracked per adapter, the order
+     * defines the bit in the adapter's extension set.
+     */
+    enum class NvapiVulkanExtension : uint32_t {
+        ExtPciBusInfo,
+        ExtMemoryBudget,
+        KhrDriverProperties,
+        KhrFragmentShadingRate,
+        NvShadingRateImage,
+        NvxImageViewHandle,
+        NvClipSpaceWScaling,
+        NvViewportArray2,
+        NvShaderSmBuiltins,
+        Count
+    };
+
+    using NvapiVulkanExtensionSet = std::bitset<static_cast<size_t>(NvapiVulkanExtension::Count)>;
+
+    constexpr uint64_t fnv1a(std::string_view value, uint64_t hash = 0xcbf29ce484222325ULL) {
+        for (auto c : value)
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+
+        return hash;
+    }
+
+    struct NvapiVulkanExtensionName {
+        NvapiVulkanExtension extension;
+        std::string_view name;
+        uint64_t hash;
+    };
+
+    // Same order as NvapiVulkanExtension
+    constexpr NvapiVulkanExtensionName vulkanExtensionNames[] = {
+        { NvapiVulkanExtension::ExtPciBusInfo,           VK_EXT_PCI_BUS_INFO_EXTENSION_NAME,           fnv1a(VK_EXT_PCI_BUS_INFO_EXTENSION_NAME) },
+        { NvapiVulkanExtension::ExtMemoryBudget,         VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,          fnv1a(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) },
+        { NvapiVulkanExtension::KhrDriverProperties,     VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME,      fnv1a(VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME) },
+        { NvapiVulkanExtension::KhrFragmentShadingRate,  VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME,  fnv1a(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME) },
+        { NvapiVulkanExtension::NvShadingRateImage,      VK_NV_SHADING_RATE_IMAGE_EXTENSION_NAME,      fnv1a(VK_NV_SHADING_RATE_IMAGE_EXTENSION_NAME) },
+        { NvapiVulkanExtension::NvxImageViewHandle,      VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME,      fnv1a(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME) },
+        { NvapiVulkanExtension::NvClipSpaceWScaling,     VK_NV_CLIP_SPACE_W_SCALING_EXTENSION_NAME,    fnv1a(VK_NV_CLIP_SPACE_W_SCALING_EXTENSION_NAME) },
+        { NvapiVulkanExtension::NvViewportArray2,        VK_NV_VIEWPORT_ARRAY2_EXTENSION_NAME,         fnv1a(VK_NV_VIEWPORT_ARRAY2_EXTENSION_NAME) },
+        { NvapiVulkanExtension::NvShaderSmBuiltins,      VK_NV_SHADER_SM_BUILTINS_EXTENSION_NAME,      fnv1a(VK_NV_SHADER_SM_BUILTINS_EXTENSION_NAME) },
+    };
+
+    static_assert(std::size(vulkanExtensionNames) == static_cast<size_t>(NvapiVulkanExtension::Count));
+
+    constexpr bool isVulkanExtensionTableOrdered() {
+        for (auto i = 0U; i < std::size(vulkanExtensionNames); i++)
+            if (static_cast<uint32_t>(vulkanExtensionNames[i].extension) != i)
+                return false;
+
+        return true;
+    }
+
+    static_assert(isVulkanExtensionTableOrdered());
+
+    // Identifies the bit layout of NvapiVulkanExtensionSet, e.g. for persisting it
+    constexpr uint64_t vulkanExtensionTableHash() {
+        auto hash = fnv1a({});
+        for (const auto& entry : vulkanExtensionNames)
+            hash = fnv1a(entry.name, hash);
+
+        return hash;
+    }
+
+    inline bool tryGetVulkanExtension(std::string_view name, NvapiVulkanExtension& extension) {
+        auto hash = fnv1a(name);
+        for (const auto& entry : vulkanExtensionNames) {
+            if (entry.hash == hash && entry.name == name) {
+                extension = entry.extension;
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
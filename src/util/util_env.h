@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../nvapi_private.h"
+#include "util_string.h"
+#include "util_log.h"
 
 namespace dxvk::env {
     std::string getEnvVariable(const std::string& name);
@@ -8,4 +10,26 @@ namespace dxvk::env {
     std::string getExecutableName();
 
     std::string getCurrentDateTime();
+
+    // Overrides are comma separated key=value pairs, unknown or rejected pairs are logged and skipped
+    template<typename T>
+    void forEachOverride(const char* envName, T apply) {
+        auto overrides = getEnvVariable(envName);
+        if (overrides.empty())
+            return;
+
+        log::write(str::format(envName, " is set to ", overrides));
+
+        std::stringstream stream(overrides);
+        std::string pair;
+        while (std::getline(stream, pair, ',')) {
+            auto separator = pair.find('=');
+            if (separator == std::string::npos)
+                continue;
+
+            auto name = pair.substr(0, separator);
+            if (!apply(name, pair.substr(separator + 1)))
+                log::write(str::format("Ignoring unknown or invalid ", envName, " entry ", pair));
+        }
+    }
 }
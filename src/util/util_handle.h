@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+namespace dxvk::handle {
+    // Handles are encoded as [type:4][generation:12][index:16] instead of
+    // being pointers, so they can be validated in constant time and stale
+    // handles from a previous initialization are never mistaken for new ones.
+    constexpr uint32_t indexBits = 16;
+    constexpr uint32_t generationBits = 12;
+    constexpr uint32_t indexMask = (1U << indexBits) - 1;
+    constexpr uint32_t generationMask = (1U << generationBits) - 1;
+
+    template<typename T>
+    constexpr uint32_t type();
+
+    template<> constexpr uint32_t type<NvPhysicalGpuHandle>() { return 1; }
+    template<> constexpr uint32_t type<NvLogicalGpuHandle>() { return 2; }
+    template<> constexpr uint32_t type<NvDisplayHandle>() { return 3; }
+
+    template<typename T>
+    T encode(const uint32_t generation, const uint32_t index) {
+        auto value = (type<T>() << (indexBits + generationBits))
+            | ((generation & generationMask) << indexBits)
+            | (index & indexMask);
+
+        return reinterpret_cast<T>(static_cast<uintptr_t>(value));
+    }
+
+    template<typename T>
+    bool decode(const T handle, const uint32_t generation, uint32_t& index) {
+        auto value = reinterpret_cast<uintptr_t>(handle);
+        if (value >> (indexBits + generationBits) != type<T>()
+            || ((value >> indexBits) & generationMask) != (generation & generationMask))
+            return false;
+
+        index = value & indexMask;
+        return true;
+    }
+}
@@ -1,6 +1,8 @@
 #include "util_log.h"
 #include "util_env.h"
 
+#include <mutex>
+
 namespace dxvk::log {
     void initialize(std::ofstream& filestream, bool& alreadyInitialized) {
         constexpr auto logPathEnvName = "DXVK_NVAPI_LOG_PATH";
@@ -21,8 +23,11 @@ namespace dxvk::log {
     }
 
     void write(const std::string& message) {
+        static std::mutex mutex;
         static std::ofstream filestream;
         static bool alreadyInitialized = false;
+
+        std::scoped_lock lock(mutex);
         if (!alreadyInitialized)
             initialize(filestream, alreadyInitialized);
 
@@ -0,0 +1,38 @@
+#include "util_rcu.h"
+
+#include <mutex>
+#include <thread>
+
+namespace dxvk::rcu {
+    // Readers register in the slot of the current epoch, a writer flips
+    // the epoch and waits until the slot of the previous one drains.
+    static std::atomic<uint64_t> epoch{};
+    static std::atomic<uint32_t> readers[2]{};
+
+    Guard::Guard() {
+        while (true) {
+            auto current = epoch.load();
+            m_slot = current & 1;
+            readers[m_slot]++;
+
+            // The epoch flipped in between, a writer may already have checked this slot
+            if (epoch.load() == current)
+                break;
+
+            readers[m_slot]--;
+        }
+    }
+
+    Guard::~Guard() {
+        readers[m_slot]--;
+    }
+
+    void synchronize() {
+        static std::mutex mutex;
+        std::scoped_lock lock(mutex);
+
+        auto previous = epoch++;
+        while (readers[previous & 1].load() != 0)
+            std::this_thread::yield();
+    }
+}
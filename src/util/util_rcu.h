@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <atomic>
+
+namespace dxvk::rcu {
+    /**
+     * \brief Read side critical section
+     *
+     * Pointers loaded from an rcu::Pointer stay valid while
+     * a guard is alive. Entering and leaving is lock-free,
+     * guards may be nested.
+     */
+    class Guard {
+
+    public:
+        Guard();
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        uint32_t m_slot;
+    };
+
+    /**
+     * \brief Waits for a grace period
+     *
+     * Returns once every guard that might still see a pointer
+     * unpublished before this call has been left. The calling
+     * thread must not hold a guard itself.
+     */
+    void synchronize();
+
+    /**
+     * \brief Guarded reference to a published object
+     */
+    template<typename T>
+    class Reference {
+
+    public:
+        explicit Reference(const std::atomic<T*>& pointer) : m_ptr(pointer.load()) {}
+
+        Reference(const Reference&) = delete;
+        Reference& operator=(const Reference&) = delete;
+
+        [[nodiscard]] T* get() const { return m_ptr; }
+        T* operator->() const { return m_ptr; }
+        bool operator==(std::nullptr_t) const { return m_ptr == nullptr; }
+        bool operator!=(std::nullptr_t) const { return m_ptr != nullptr; }
+
+    private:
+        Guard m_guard;
+        T* m_ptr;
+    };
+
+    /**
+     * \brief Atomically published pointer
+     *
+     * Readers acquire a guarded reference, writers exchange the
+     * pointer and free the previous object after synchronize().
+     */
+    template<typename T>
+    class Pointer {
+
+    public:
+        [[nodiscard]] Reference<T> Acquire() const { return Reference<T>(m_ptr); }
+
+        // Only valid while the caller holds a guard
+        [[nodiscard]] T* Load() const { return m_ptr.load(); }
+
+        T* Exchange(T* ptr) { return m_ptr.exchange(ptr); }
+
+    private:
+        std::atomic<T*> m_ptr{};
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../nvapi_private.h"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace dxvk {
+    /**
+     * \brief Single writer sequence lock
+     *
+     * Readers never block and never write shared state, they
+     * retry while a store is in progress. The value is kept as
+     * relaxed atomic words, so torn reads are detected instead
+     * of being undefined behavior.
+     */
+    template<typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint32_t) == 0);
+
+        static constexpr size_t wordCount = sizeof(T) / sizeof(uint32_t);
+
+    public:
+        void Store(const T& value) {
+            uint32_t words[wordCount];
+            std::memcpy(words, &value, sizeof(T));
+
+            auto sequence = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (auto i = 0U; i < wordCount; i++)
+                m_words[i].store(words[i], std::memory_order_relaxed);
+
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        [[nodiscard]] T Load() const {
+            uint32_t words[wordCount];
+            while (true) {
+                auto sequence = m_sequence.load(std::memory_order_acquire);
+                if (sequence & 1)
+                    continue;
+
+                for (auto i = 0U; i < wordCount; i++)
+                    words[i] = m_words[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == sequence)
+                    break;
+            }
+
+            T value;
+            std::memcpy(&value, words, sizeof(T));
+            return value;
+        }
+
+    private:
+        std::atomic<uint32_t> m_sequence{};
+        std::atomic<uint32_t> m_words[wordCount]{};
+    };
+}
@@ -55,6 +55,19 @@ namespace dxvk {
         return NVAPI_NO_IMPLEMENTATION;
     }
 
+    inline NvAPI_Status NotSupported(const std::string& logMessage) {
+        log::write(str::format(logMessage, ": Not supported"));
+        return NVAPI_NOT_SUPPORTED;
+    }
+
+    inline NvAPI_Status NotSupported(const std::string& logMessage, bool& alreadyLogged) {
+        if (std::exchange(alreadyLogged, true))
+            return NVAPI_NOT_SUPPORTED;
+
+        log::write(str::format(logMessage, ": Not supported"));
+        return NVAPI_NOT_SUPPORTED;
+    }
+
     inline NvAPI_Status EndEnumeration(const std::string& logMessage) {
         log::write(str::format(logMessage, ": End enumeration"));
         return NVAPI_END_ENUMERATION;
@@ -75,6 +88,11 @@ namespace dxvk {
         return NVAPI_EXPECTED_PHYSICAL_GPU_HANDLE;
     }
 
+    inline NvAPI_Status ExpectedLogicalGpuHandle(const std::string& logMessage) {
+        log::write(str::format(logMessage, ": Expected logical GPU handle"));
+        return NVAPI_EXPECTED_LOGICAL_GPU_HANDLE;
+    }
+
     inline NvAPI_Status IncompatibleStructVersion(const std::string& logMessage) {
         log::write(str::format(logMessage, ": Incompatible struct version"));
         return NVAPI_INCOMPATIBLE_STRUCT_VERSION;
@@ -90,6 +108,16 @@ namespace dxvk {
         return NVAPI_INVALID_DISPLAY_ID;
     }
 
+    inline NvAPI_Status InsufficientBuffer(const std::string& logMessage) {
+        log::write(str::format(logMessage, ": Insufficient buffer"));
+        return NVAPI_INSUFFICIENT_BUFFER;
+    }
+
+    inline NvAPI_Status DataNotFound(const std::string& logMessage) {
+        log::write(str::format(logMessage, ": Data not found"));
+        return NVAPI_DATA_NOT_FOUND;
+    }
+
     inline NvAPI_Status MosaicNotActive(const std::string& logMessage) {
         log::write(str::format(logMessage, ": Mosaic not active"));
         return NVAPI_MOSAIC_NOT_ACTIVE;
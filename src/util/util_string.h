@@ -2,6 +2,9 @@
 
 #include "../nvapi_private.h"
 
+#include <cstring>
+#include <string_view>
+
 namespace dxvk::str {
     std::string fromws(const WCHAR* ws);
 
@@ -14,6 +17,14 @@ namespace dxvk::str {
 
     std::wstring tows(const char* mbs);
 
+    // Copies into a fixed size NvAPI string, truncating if necessary
+    template <size_t N>
+    void tonvss(char (&nvss)[N], std::string_view value) {
+        auto length = std::min(value.size(), N - 1);
+        std::memcpy(nvss, value.data(), length);
+        nvss[length] = '\0';
+    }
+
     inline void format1(std::stringstream&) { }
 
     template<typename... Tx>
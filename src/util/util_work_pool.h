@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dxvk {
+    /**
+     * \brief Fixed set of threads working off indexed items
+     *
+     * Every thread takes the next pending index until all are
+     * taken. Callers store results by index, so their order does
+     * not depend on scheduling. The thread count is not limited
+     * by the CPU count, work items are expected to mostly block.
+     * Does not depend on any Windows header, which keeps it
+     * usable from the benchmarks.
+     */
+    class WorkPool {
+
+    public:
+        WorkPool() = default;
+
+        ~WorkPool() {
+            Join();
+        }
+
+        WorkPool(const WorkPool&) = delete;
+        WorkPool& operator=(const WorkPool&) = delete;
+
+        template<typename F>
+        void Start(const size_t count, const unsigned maxThreads, F work) {
+            auto threadCount = std::min(static_cast<unsigned>(count), maxThreads);
+
+            m_next = 0;
+            for (auto i = 0U; i < threadCount; i++)
+                m_threads.emplace_back([this, count, work] {
+                    for (auto index = m_next++; index < count; index = m_next++)
+                        work(index);
+                });
+        }
+
+        void Join() {
+            for (auto& thread : m_threads)
+                thread.join();
+
+            m_threads.clear();
+        }
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::atomic<size_t> m_next{};
+    };
+}